@@ -0,0 +1,184 @@
+/*
+ *  Created by thahnen on 18.10.26.
+ *
+ *  C interface of the library: images are passed as raw buffers (no OpenCV needed on the calling side), every result
+ *  gets written into buffers provided by the caller. Usable from C and every language with a C FFI.
+ */
+
+
+#ifndef AIOLOS_C_H
+#define AIOLOS_C_H
+
+#include <stddef.h>
+
+#if defined (_WIN32) || defined (__CYGWIN__)
+#   if defined (__GNUC__)
+#       define AIOLOS_API __attribute__ ((dllexport))
+#   elif defined (_MSC_VER)
+#       define AIOLOS_API __declspec(dllexport)
+#   endif
+#else
+#   define AIOLOS_API __attribute__ ((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/** Result of every function */
+typedef enum {
+    AIOLOS_OK = 0,                      /* everything went fine */
+    AIOLOS_INVALID_ARGUMENT,            /* wrong argument (see aiolos_last_error) */
+    AIOLOS_BUFFER_TOO_SMALL,            /* output buffer too small (nothing written) */
+    AIOLOS_ERROR                        /* calculation failed (see aiolos_last_error) */
+} aiolos_status;
+
+
+/** Type of a single pixel (single channel only) */
+typedef enum {
+    AIOLOS_GRAY8 = 0,                   /* unsigned 8 bit */
+    AIOLOS_GRAY8S,                      /* signed 8 bit */
+    AIOLOS_GRAY16,                      /* unsigned 16 bit */
+    AIOLOS_GRAY16S,                     /* signed 16 bit */
+    AIOLOS_GRAY32S                      /* signed 32 bit */
+} aiolos_pixel_format;
+
+
+/** Image in a buffer of the caller (never copied, only read) */
+typedef struct {
+    const void* data;                   /* first pixel of the first row */
+    int width;                          /* number of pixels per row */
+    int height;                         /* number of rows */
+    size_t stride;                      /* number of bytes from one row to the next (0 => rows without padding) */
+    aiolos_pixel_format format;         /* type of every pixel */
+} aiolos_image;
+
+
+/** Settings of a calculation, values equal GLCM::Options / GLCM::Implementation (see GLCM.h) */
+typedef struct {
+    int implementation;                 /* GLCM::Implementation: 0 = Standard, 1 = Scheme 1, 2 = Scheme 2, 3 = Scheme 3 */
+    unsigned int first_angle;           /* range of angles considered (both included, in degrees, at most 179) */
+    unsigned int last_angle;
+    unsigned int max_r;                 /* fixed maximum radius or, if 0, one based on the image boundaries */
+
+    int engine;                         /* GLCM::Engine: 0 = MATRIX, 1 = DIFFERENCE, 2 = AUTOCORRELATION */
+    unsigned int levels;                /* number of gray levels the image gets quantized to (0 => none) */
+    int search;                         /* GLCM::Search: 0 = FULL, 1 = COARSE_TO_FINE, 2 = PYRAMID */
+    int schedule;                       /* GLCM::Schedule: 0 = EVERY_RADIUS, 1 = STRIDE, 2 = GEOMETRIC */
+    unsigned int stride;                /* distance of two radii (STRIDE only) */
+    double factor;                      /* ratio of two radii (GEOMETRIC only) */
+    unsigned int tile_size;             /* edge length of the tiles (DIFFERENCE only, not Scheme 1, 0 => none) */
+} aiolos_options;
+
+
+/**
+ *  Fills the options with the default values (Standard, 0 ... 179, everything else as described in the paper)
+ *
+ *  @param options      the options to fill
+ */
+AIOLOS_API void aiolos_default_options(aiolos_options* options);
+
+
+/**
+ *  Calculates the dominant angle of an image (see GLCM::main_angle)
+ *
+ *  @param image        the image
+ *  @param options      the settings or NULL => default values
+ *  @param angle        the returned dominant angle (in degrees)
+ *  @return             AIOLOS_OK or the error
+ */
+AIOLOS_API aiolos_status aiolos_main_angle(const aiolos_image* image, const aiolos_options* options,
+                                          unsigned int* angle);
+
+
+/**
+ *  Calculates the degree of concentration of every angle of the range (first_angle ... last_angle)
+ *
+ *  @param image        the image
+ *  @param options      the settings or NULL => default values (search gets ignored, every angle is calculated)
+ *  @param distribution the returned values (one per angle, in the order of the angles)
+ *  @param capacity     number of values the distribution holds (at least last_angle - first_angle + 1)
+ *  @return             AIOLOS_OK or the error
+ */
+AIOLOS_API aiolos_status aiolos_angle_distribution(const aiolos_image* image, const aiolos_options* options,
+                                                   double* distribution, size_t capacity);
+
+
+/**
+ *  Calculates the dominant angles of an image (see GLCM::main_angles, duplicates possible)
+ *
+ *  @param image        the image
+ *  @param options      the settings or NULL => default values
+ *  @param method       GLCM::Method (e.g. 15 = MEDIAN, see impl/Definitions.h)
+ *  @param angles       the returned angles (in degrees)
+ *  @param capacity     number of angles the buffer holds
+ *  @param count        the returned number of angles (also set if the buffer is too small)
+ *  @return             AIOLOS_OK or the error
+ */
+AIOLOS_API aiolos_status aiolos_main_angles(const aiolos_image* image, const aiolos_options* options, int method,
+                                           unsigned int* angles, size_t capacity, size_t* count);
+
+
+/** Estimator of many images using the same settings, its scratch memory gets reused (see GLCM::Estimator) */
+typedef struct aiolos_estimator aiolos_estimator;
+
+
+/**
+ *  Creates an estimator, everything not depending on the image gets done once (angles, radii, threads)
+ *
+ *  @param options      the settings or NULL => default values
+ *  @param estimator    the returned estimator (to be freed using aiolos_estimator_destroy)
+ *  @return             AIOLOS_OK or the error
+ */
+AIOLOS_API aiolos_status aiolos_estimator_create(const aiolos_options* options, aiolos_estimator** estimator);
+
+
+/**
+ *  Calculates the dominant angle of an image, no allocation once an image of the same size and type was calculated
+ *  (see GLCM::Estimator for the settings falling back to aiolos_main_angle)
+ *
+ *  @param estimator    the estimator (concurrent calls get serialized)
+ *  @param image        the image
+ *  @param angle        the returned dominant angle (in degrees)
+ *  @return             AIOLOS_OK or the error
+ */
+AIOLOS_API aiolos_status aiolos_estimator_estimate(aiolos_estimator* estimator, const aiolos_image* image,
+                                                  unsigned int* angle);
+
+
+/**
+ *  Calculates the degree of concentration of every angle of the range, written directly into the buffer
+ *
+ *  @param estimator    the estimator (concurrent calls get serialized)
+ *  @param image        the image
+ *  @param distribution the returned values (one per angle, in the order of the angles)
+ *  @param capacity     number of values the distribution holds (at least last_angle - first_angle + 1)
+ *  @return             AIOLOS_OK or the error
+ */
+AIOLOS_API aiolos_status aiolos_estimator_distribution(aiolos_estimator* estimator, const aiolos_image* image,
+                                                      double* distribution, size_t capacity);
+
+
+/**
+ *  Frees an estimator and its scratch memory
+ *
+ *  @param estimator    the estimator or NULL (nothing happens)
+ */
+AIOLOS_API void aiolos_estimator_destroy(aiolos_estimator* estimator);
+
+
+/**
+ *  Returns the message of the last error of the calling thread
+ *
+ *  @return             the message (empty if there was none, valid until the next call of the calling thread)
+ */
+AIOLOS_API const char* aiolos_last_error(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* AIOLOS_C_H */
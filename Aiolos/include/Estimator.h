@@ -0,0 +1,87 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#pragma once
+#ifndef AIOLOS_ESTIMATOR_H
+#define AIOLOS_ESTIMATOR_H
+
+#include <mutex>
+#include <memory>
+#include <opencv2/opencv.hpp>
+
+#include "GLCM.h"
+
+
+namespace GLCM {
+    /**
+     *  Calculates the dominant angle of many images using the same settings: everything not depending on the image
+     *  itself is done once when the estimator gets configured (angles, radii, offset table, number of threads). Every
+     *  thread owns its scratch memory (rotated image, GLCMs of its arena, see GLCM::arena_glcm) and the prepared image
+     *  gets stored to a buffer of its own, all of them reused by the following calls. Once the first image of a size
+     *  was calculated every further call with an image of the same size and type allocates nothing on the heap.
+     *
+     *  REVIEW: Same result as GLCM::main_angle / GLCM::getAngleDistribution with the same settings (exact sums)
+     *  REVIEW: The worker threads are the (persistent) OpenMP thread pool, the size of the team gets fixed once
+     *  REVIEW: Thread-safe: concurrent calls get serialized, every call already uses all of the worker threads
+     *  NOBUG:  Everything but options.search = FULL, options.stable_radii = 0, options.tile_size = 0 and the MATRIX /
+     *          DIFFERENCE engine (sparse GLCMs as well) falls back to GLCM::main_angle (allocating as usual),
+     *          Estimator::distribution only needs the latter three
+     *  NOBUG:  Scheme 1 rotates using OpenCV, which may allocate temporaries of its own (fewer angles than threads: the
+     *          rotations of all angles get collected in a vector of their own every call)
+     */
+    class DLL Estimator {
+    public:
+        /**
+         *  @param impl         which implementation of the GLCM shall be used
+         *  @param range        interval of angles to consider!
+         *  @param max_r        fixed maximum radius or, if not stated, one based on the image boundaries
+         *  @param options      additional settings (e.g. levels every image gets quantized to, the radius schedule)
+         */
+        Estimator(Implementation impl, const Range& range = Range(0, 179), unsigned int max_r = 0,
+                  const Options& options = Options());
+
+        ~Estimator();
+
+
+        /**
+         *  Calculates the dominant angle of an image
+         *
+         *  @param image        the given image (single channel)
+         *  @return             the dominant angle (in degrees!)
+         */
+        unsigned int estimate(const cv::Mat& image);
+
+
+        /**
+         *  Calculates the degree of concentration of every angle of the range (options.search gets ignored)
+         *
+         *  @param image        the given image (single channel)
+         *  @param distribution the returned values (one per angle of the range, in the order of the angles)
+         */
+        void distribution(const cv::Mat& image, double* distribution);
+
+
+        /// Scratch memory, offset table etc. (only defined inside of Estimator.cpp)
+        struct Context;
+
+    private:
+        /// Quantizes / compacts the image into the buffer of the context (see GLCM::prepare_image)
+        const cv::Mat& prepare(const cv::Mat& image, int& max_gray);
+
+        /// Calculates the distribution of the prepared image into the given buffer (one value per angle)
+        void calculate(const cv::Mat& gray, int max_gray, double* distribution);
+
+        Implementation impl;
+        Range range;
+        unsigned int max_r;
+        Options options;
+
+        std::mutex mutex;
+        std::unique_ptr<Context> context;
+    };
+}
+
+
+#endif //AIOLOS_ESTIMATOR_H
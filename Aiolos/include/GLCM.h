@@ -33,9 +33,11 @@ namespace GLCM {
      *  @param image        the given image
      *  @param impl         which implementation of the GLCM shall be used
      *  @param max_r        fixed maximum radius or, if not stated, one based on the image boundaries
+     *  @param options      additional settings (e.g. which engine calculates the degree of concentration)
      *  @return             the dominant angle (in degrees!)
      */
-    DLL unsigned int main_angle(const cv::Mat& image, GLCM::Implementation impl, unsigned int max_r = 0);
+    DLL unsigned int main_angle(const cv::Mat& image, GLCM::Implementation impl, unsigned int max_r = 0,
+                                    const GLCM::Options& options = GLCM::Options());
 
 
     /**
@@ -46,10 +48,11 @@ namespace GLCM {
      *  @param impl         which implementation of the GLCM shall be used
      *  @param range        interval of angles to consider!
      *  @param max_r        fixed maximum radius or, if not stated, one based on the image boundaries
+     *  @param options      additional settings (e.g. which engine calculates the degree of concentration)
      *  @return             the dominant angle (in degrees!)
      */
     DLL unsigned int main_angle(const cv::Mat& image, GLCM::Implementation impl, const GLCM::Range& range,
-                                    unsigned int max_r = 0);
+                                    unsigned int max_r = 0, const GLCM::Options& options = GLCM::Options());
 
 
     /**
@@ -59,10 +62,12 @@ namespace GLCM {
      *  @param impl         which implementation of the GLCM shall be used
      *  @param meth         which method is used to get the angles
      *  @param max_r        fixed maximum radius or, if not stated, one based on the image boundaries
+     *  @param options      additional settings (e.g. which engine calculates the degree of concentration)
      *  @return             the dominant angle(s) (in degrees!)
      */
     DLL std::vector<unsigned int> main_angles(const cv::Mat& image, GLCM::Implementation impl, GLCM::Method meth,
-                                                        unsigned int max_r = 0);
+                                                        unsigned int max_r = 0,
+                                                        const GLCM::Options& options = GLCM::Options());
 
 
     /**
@@ -74,10 +79,12 @@ namespace GLCM {
      *  @param meth         which method is used to get the angles
      *  @param range        interval of angles to consider!
      *  @param max_r        fixed maximum radius or, if not stated, one based on the image boundaries
+     *  @param options      additional settings (e.g. which engine calculates the degree of concentration)
      *  @return             the dominant angle(s) (in degrees!)
      */
     DLL std::vector<unsigned int> main_angles(const cv::Mat& image, GLCM::Implementation impl, GLCM::Method meth,
-                                                const GLCM::Range& range, unsigned int max_r = 0);
+                                                const GLCM::Range& range, unsigned int max_r = 0,
+                                                const GLCM::Options& options = GLCM::Options());
 
 
     /**
@@ -87,10 +94,12 @@ namespace GLCM {
      *  @param impl         which implementation of the GLCM shall be used
      *  @param meth         which method is used to get the angles
      *  @param max_r        fixed maximum radius or, if not stated, one based on the image boundaries
+     *  @param options      additional settings (e.g. which engine calculates the degree of concentration)
      *  @return             the dominant angle(s) (in degrees!)
      */
     DLL std::set<unsigned int> main_angles_set(const cv::Mat& image, GLCM::Implementation impl, GLCM::Method meth,
-                                                        unsigned int max_r = 0);
+                                                        unsigned int max_r = 0,
+                                                        const GLCM::Options& options = GLCM::Options());
 
 
     /**
@@ -102,42 +111,202 @@ namespace GLCM {
      *  @param meth         which method is used to get the angles
      *  @param range        interval of angles to consider!
      *  @param max_r        fixed maximum radius or, if not stated, one based on the image boundaries
+     *  @param options      additional settings (e.g. which engine calculates the degree of concentration)
      *  @return             the dominant angle(s) (in degrees!)
      */
     DLL std::set<unsigned int> main_angles_set(const cv::Mat& image, GLCM::Implementation impl, GLCM::Method meth,
-                                                const GLCM::Range& range, unsigned int max_r = 0);
+                                                const GLCM::Range& range, unsigned int max_r = 0,
+                                                const GLCM::Options& options = GLCM::Options());
 
 
 
+    /**
+     *  Calculates the dominant texture orientation of every image of a batch. All the work items of all images
+     *  (angle and radius of an image) get scheduled on one parallel region instead of one per image, therefore
+     *  small images keep every thread busy.
+     *
+     *  @param images       the given images
+     *  @param impl         which implementation of the GLCM shall be used
+     *  @param range        interval of angles to consider!
+     *  @param max_r        fixed maximum radius or, if not stated, one based on the boundaries of every image
+     *  @param options      additional settings for every image (same size as images) or, if empty, the default ones
+     *  @return             the dominant angle of every image (in degrees, same order as the images)
+     *
+     *  NOBUG:  Images not made of independent (angle, radius) pairs (COARSE_TO_FINE / PYRAMID search, tiles,
+     *          AUTOCORRELATION, stable_radii) get calculated one after another after the shared parallel region,
+     *          every one as a call of GLCM::main_angle of its own (parallel on its own)
+     */
+    DLL std::vector<unsigned int> main_angle_batch(const std::vector<cv::Mat>& images, GLCM::Implementation impl,
+                                                    const GLCM::Range& range = GLCM::Range(0, 179),
+                                                    unsigned int max_r = 0,
+                                                    const std::vector<GLCM::Options>& options = {});
+
+
+    /**
+     *  Calculates the dominant texture orientations of every image of a batch (one or more + duplicates possible).
+     *  All the work items of all images get scheduled on one parallel region instead of one per image.
+     *
+     *  @param images       the given images
+     *  @param impl         which implementation of the GLCM shall be used
+     *  @param meth         which method is used to get the angles
+     *  @param range        interval of angles to consider!
+     *  @param max_r        fixed maximum radius or, if not stated, one based on the boundaries of every image
+     *  @param options      additional settings for every image (same size as images) or, if empty, the default ones
+     *  @return             the dominant angle(s) of every image (in degrees, same order as the images)
+     *
+     *  NOBUG:  Split methods (SPLIT_IMAGE_*) and images not made of independent (angle, radius) pairs get calculated
+     *          one after another after the shared parallel region (see GLCM::main_angle_batch)
+     */
+    DLL std::vector<std::vector<unsigned int>> main_angles_batch(const std::vector<cv::Mat>& images,
+                                                                  GLCM::Implementation impl, GLCM::Method meth,
+                                                                  const GLCM::Range& range = GLCM::Range(0, 179),
+                                                                  unsigned int max_r = 0,
+                                                                  const std::vector<GLCM::Options>& options = {});
+
+    /**
+     *  Calculates the dominant texture orientation of every region of interest of the image (one angle per region).
+     *  Every (angle, radius) pair scans the image only once (integral image of the squared differences of all pairs),
+     *  therefore any number of regions costs about the same as a single pass over the whole image.
+     *
+     *  @param image        the given image
+     *  @param rois         the regions of interest (inside the image, may overlap)
+     *  @param impl         which implementation of the GLCM shall be used
+     *  @param range        interval of angles to consider!
+     *  @param max_r        fixed maximum radius or, if not stated, one based on the boundaries of every region
+     *  @param options      additional settings (e.g. which engine calculates the degree of concentration)
+     *  @return             the dominant angle of every region (in degrees, same order as the regions)
+     *
+     *  REVIEW: Equals GLCM::main_angle of every region cut out of the image, Scheme 1 and searches / schedules
+     *          depending on the region itself (COARSE_TO_FINE, PYRAMID, stable_radii) calculate every region on its own!
+     *  NOBUG:  Every region sums up differences of gray values (as the DIFFERENCE engine does) => for images deeper
+     *          than 8 bit (not quantized) Scheme 2 may differ slightly from GLCM::main_angle of the region using the
+     *          MATRIX engine, which compacts the region first (see GLCM::prepare_image), signed images get compacted
+     *          once for all regions instead of region by region
+     */
+    DLL std::vector<unsigned int> main_angle_rois(const cv::Mat& image, const std::vector<cv::Rect>& rois,
+                                                    GLCM::Implementation impl,
+                                                    const GLCM::Range& range = GLCM::Range(0, 179),
+                                                    unsigned int max_r = 0,
+                                                    const GLCM::Options& options = GLCM::Options());
+
+
+    /**
+     *  Calculates the dominant texture orientation of every sub-image of a grid (every pixel belongs to exactly one).
+     *
+     *  @param image        the given image
+     *  @param impl         which implementation of the GLCM shall be used
+     *  @param grid         number of sub-images in width and height
+     *  @param range        interval of angles to consider!
+     *  @param max_r        fixed maximum radius or, if not stated, one based on the boundaries of every sub-image
+     *  @param options      additional settings (e.g. which engine calculates the degree of concentration)
+     *  @return             the dominant angle of every sub-image (in degrees, row by row, every row left to right)
+     *
+     *  @see    GLCM::main_angle_rois
+     */
+    DLL std::vector<unsigned int> main_angle_grid(const cv::Mat& image, GLCM::Implementation impl,
+                                                    const cv::Size& grid,
+                                                    const GLCM::Range& range = GLCM::Range(0, 179),
+                                                    unsigned int max_r = 0,
+                                                    const GLCM::Options& options = GLCM::Options());
+
+    /**
+     *  Calculates the dominant texture orientation of every window sliding over the image (one angle per window).
+     *  Every (angle, radius) pair scans the image only once (integral image of the squared differences of all pairs),
+     *  the degree of concentration of every window is a lookup afterwards.
+     *
+     *  @param image        the given image
+     *  @param impl         which implementation of the GLCM shall be used (all but Scheme 1)
+     *  @param window       size of the windows (every window equals the sub-image cut out of the image)
+     *  @param stride       distance of two neighbouring windows (1 x 1 => one angle per pixel)
+     *  @param range        interval of angles to consider!
+     *  @param max_r        fixed maximum radius or, if not stated, one based on the window boundaries
+     *  @param options      additional settings (levels and radius schedule, the rest gets ignored)
+     *  @return             the dominant angle of every window (CV_32S, in degrees!)
+     *
+     *  NOBUG:  Same as GLCM::main_angle_rois for Scheme 2 on images deeper than 8 bit
+     */
+    DLL cv::Mat orientation_map(const cv::Mat& image, GLCM::Implementation impl, const cv::Size& window,
+                                    const cv::Size& stride, const GLCM::Range& range = GLCM::Range(0, 179),
+                                    unsigned int max_r = 0, const GLCM::Options& options = GLCM::Options());
+
+
+    /**
+     *  Calculates the dominant texture orientation and its strength of every window sliding over the image.
+     *  The strength is 1 - min / mean of the distribution of the window: 0 for no dominant angle at all, close to 1
+     *  for a strongly oriented texture.
+     *
+     *  @param image        the given image
+     *  @param strength     the returned strength of every window (CV_64F, same size as the returned angles)
+     *  @see    GLCM::orientation_map(const cv::Mat&, GLCM::Implementation, const cv::Size&, const cv::Size&, const GLCM::Range&, unsigned int, const GLCM::Options&)
+     */
+    DLL cv::Mat orientation_map(const cv::Mat& image, cv::Mat& strength, GLCM::Implementation impl,
+                                    const cv::Size& window, const cv::Size& stride,
+                                    const GLCM::Range& range = GLCM::Range(0, 179), unsigned int max_r = 0,
+                                    const GLCM::Options& options = GLCM::Options());
+
+
+    /**
+     *  Calculates Haralick statistics of every (angle, radius) pair together with the distribution of the angles:
+     *  every GLCM gets created once and walked once for all of them (instead of a second pass for the statistics).
+     *  The dominant angle is range.first + the index of the lowest value of the distribution.
+     *
+     *  @param image        the given image
+     *  @param impl         which implementation of the GLCM shall be used
+     *  @param features     the requested features (GLCM::TextureFeature flags, the others stay 0)
+     *  @param range        interval of angles to consider!
+     *  @param max_r        fixed maximum radius or, if not stated, one based on the image boundaries
+     *  @param options      additional settings (levels and radius schedule, the rest gets ignored)
+     *  @return             the features of every pair and the distribution of the angles
+     *
+     *  REVIEW: Statistics are based on the prepared image (quantized to options.levels or compacted), every GLCM gets
+     *          created (MATRIX engine) => the distribution equals the one of every other engine
+     */
+    DLL GLCM::TextureFeatureMap texture_features(const cv::Mat& image, GLCM::Implementation impl,
+                                                     int features = GLCM::ALL_TEXTURE_FEATURES,
+                                                     const GLCM::Range& range = GLCM::Range(0, 179),
+                                                     unsigned int max_r = 0,
+                                                     const GLCM::Options& options = GLCM::Options());
+
+
+    /**
+     *  Aggregates the features of every angle: the mean of the features of all its radii
+     *
+     *  @param map          the features of every (angle, radius) pair (see GLCM::texture_features)
+     *  @return             the features of every angle (in the order of map.angles)
+     */
+    DLL std::vector<GLCM::TextureFeatures> features_per_angle(const GLCM::TextureFeatureMap& map);
+
 #ifdef AIOLOS_FEATURE_MORE_TYPE_SUPPORT
     /**
      *  Calculates the one dominant texture orientation of an image for specific angles.
      *  Range of angles can be restricted by setting range to an interval [A,B] := { x ∈ ℝ | A ≤ x ≤ B }
      *
-     *  @see    GLCM::main_angle(const cv::Mat&, GLCM::Implementation, const GLCM::Range&, unsigned int)
+     *  @see    GLCM::main_angle(const cv::Mat&, GLCM::Implementation, const GLCM::Range&, unsigned int, const GLCM::Options&)
      */
     DLL unsigned int main_angle(const cv::Mat& image, GLCM::Implementation impl, const cv::Range& range,
-                                    unsigned int max_r = 0);
+                                    unsigned int max_r = 0, const GLCM::Options& options = GLCM::Options());
 
 
     /**
      *  Calculates the dominant texture orientations of the image (one or more + duplicates possible) for specific angles.
      *  Range of angles can be restricted by setting range to an interval [A,B] := { x ∈ ℝ | A ≤ x ≤ B }
      *
-     *  @see    GLCM::main_angles(const cv::Mat&, GLCM::Implementation, GLCM::Method, const GLCM::Range&, unsigned int)
+     *  @see    GLCM::main_angles(const cv::Mat&, GLCM::Implementation, GLCM::Method, const GLCM::Range&, unsigned int, const GLCM::Options&)
      */
     DLL std::vector<unsigned int> main_angles(const cv::Mat& image, GLCM::Implementation impl, GLCM::Method meth,
-                                                const cv::Range& range, unsigned int max_r = 0);
+                                                const cv::Range& range, unsigned int max_r = 0,
+                                                const GLCM::Options& options = GLCM::Options());
 
 
     /**
      *  Calculates the dominant texture orientations of the image (one or more possible) for specific angles.
      *  Range of angles can be restricted by setting range to an interval [A,B] := { x ∈ ℝ | A ≤ x ≤ B }
      *
-     *  @see    GLCM::main_angles_set(const cv::Mat&, GLCM::Implementation, GLCM::Method, const GLCM::Range&, unsigned int)
+     *  @see    GLCM::main_angles_set(const cv::Mat&, GLCM::Implementation, GLCM::Method, const GLCM::Range&, unsigned int, const GLCM::Options&)
      */
     DLL std::set<unsigned int> main_angles_set(const cv::Mat& image, GLCM::Implementation impl, GLCM::Method meth,
-                                                const cv::Range& range, unsigned int max_r = 0);
+                                                const cv::Range& range, unsigned int max_r = 0,
+                                                const GLCM::Options& options = GLCM::Options());
 #endif
 
 
@@ -150,10 +319,11 @@ namespace GLCM {
      *  @param boundaries   the boundaries for a sub image
      *  @param impl         which implementation of the GLCM shall be used
      *  @param max_r        fixed maximum radius or, if not stated, one based on the image boundaries
+     *  @param options      additional settings (e.g. which engine calculates the degree of concentration)
      *  @return             the dominant angle (in degrees!)
      */
     DLL unsigned int main_angle(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                    unsigned int max_r = 0);
+                                    unsigned int max_r = 0, const GLCM::Options& options = GLCM::Options());
 
 
     /**
@@ -165,10 +335,12 @@ namespace GLCM {
      *  @param impl         which implementation of the GLCM shall be used
      *  @param range        interval of angles to consider!
      *  @param max_r        fixed maximum radius or, if not stated, one based on the image boundaries
+     *  @param options      additional settings (e.g. which engine calculates the degree of concentration)
      *  @return             the dominant angle (in degrees!)
      */
     DLL unsigned int main_angle(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                    const GLCM::Range& range, unsigned int max_r = 0);
+                                    const GLCM::Range& range, unsigned int max_r = 0,
+                                    const GLCM::Options& options = GLCM::Options());
 
 
     /**
@@ -179,10 +351,12 @@ namespace GLCM {
      *  @param impl         which implementation of the GLCM shall be used
      *  @param meth         which method is used to get the angles
      *  @param max_r        fixed maximum radius or, if not stated, one based on the image boundaries
+     *  @param options      additional settings (e.g. which engine calculates the degree of concentration)
      *  @return             the dominant angle(s) (in degrees!)
      */
     DLL std::vector<unsigned int> main_angles(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                                GLCM::Method meth, unsigned int max_r = 0);
+                                                GLCM::Method meth, unsigned int max_r = 0,
+                                                const GLCM::Options& options = GLCM::Options());
 
 
     /**
@@ -195,10 +369,12 @@ namespace GLCM {
      *  @param meth         which method is used to get the angles
      *  @param range        interval of angles to consider!
      *  @param max_r        fixed maximum radius or, if not stated, one based on the image boundaries
+     *  @param options      additional settings (e.g. which engine calculates the degree of concentration)
      *  @return             the dominant angle(s) (in degrees!)
      */
     DLL std::vector<unsigned int> main_angles(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                                GLCM::Method meth, const GLCM::Range& range, unsigned int max_r = 0);
+                                                GLCM::Method meth, const GLCM::Range& range, unsigned int max_r = 0,
+                                                const GLCM::Options& options = GLCM::Options());
 
 
     /**
@@ -209,10 +385,12 @@ namespace GLCM {
      *  @param impl         which implementation of the GLCM shall be used
      *  @param meth         which method is used to get the angles
      *  @param max_r        fixed maximum radius or, if not stated, one based on the image boundaries
+     *  @param options      additional settings (e.g. which engine calculates the degree of concentration)
      *  @return             the dominant angle(s) (in degrees!)
      */
     DLL std::set<unsigned int> main_angles_set(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                                GLCM::Method meth, unsigned int max_r = 0);
+                                                GLCM::Method meth, unsigned int max_r = 0,
+                                                const GLCM::Options& options = GLCM::Options());
 
 
     /**
@@ -225,10 +403,12 @@ namespace GLCM {
      *  @param meth         which method is used to get the angles
      *  @param range        interval of angles to consider!
      *  @param max_r        fixed maximum radius or, if not stated, one based on the image boundaries
+     *  @param options      additional settings (e.g. which engine calculates the degree of concentration)
      *  @return             the dominant angle(s) (in degrees!)
      */
     DLL std::set<unsigned int> main_angles_set(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                                GLCM::Method meth, const GLCM::Range& range, unsigned int max_r = 0);
+                                                GLCM::Method meth, const GLCM::Range& range, unsigned int max_r = 0,
+                                                const GLCM::Options& options = GLCM::Options());
 
 
 #ifdef AIOLOS_FEATURE_MORE_TYPE_SUPPORT
@@ -236,30 +416,33 @@ namespace GLCM {
      *  Calculates the one dominant texture orientation of a sub-image for specific angles.
      *  Range of angles can be restricted by setting range to an interval [A,B] := { x ∈ ℝ | A ≤ x ≤ B }
      *
-     *  @see    GLCM::main_angle(const cv::Mat&, const cv::Rect&, GLCM::Implementation, const cv::Range&, unsigned int)
+     *  @see    GLCM::main_angle(const cv::Mat&, const cv::Rect&, GLCM::Implementation, const cv::Range&, unsigned int, const GLCM::Options&)
      */
     DLL unsigned int main_angle(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                    const cv::Range& range, unsigned int max_r = 0);
+                                    const cv::Range& range, unsigned int max_r = 0,
+                                    const GLCM::Options& options = GLCM::Options());
 
 
     /**
      *  Calculates the dominant texture orientations of the sub-image (one or more + duplicates possible) for specific angles.
      *  Range of angles can be restricted by setting range to an interval [A,B] := { x ∈ ℝ | A ≤ x ≤ B }
      *
-     *  @see    GLCM::main_angles(const cv::Mat&, const cv::Rect&, GLCM::Implementation, GLCM::Method, const GLCM::Range&, unsigned int)
+     *  @see    GLCM::main_angles(const cv::Mat&, const cv::Rect&, GLCM::Implementation, GLCM::Method, const GLCM::Range&, unsigned int, const GLCM::Options&)
      */
     DLL std::vector<unsigned int> main_angles(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                                GLCM::Method meth, const cv::Range& range, unsigned int max_r = 0);
+                                                GLCM::Method meth, const cv::Range& range, unsigned int max_r = 0,
+                                                const GLCM::Options& options = GLCM::Options());
 
 
     /**
      *  Calculates the dominant texture orientations of the sub-image (one or more possible) for specific angles.
      *  Range of angles can be restricted by setting range to an interval [A,B] := { x ∈ ℝ | A ≤ x ≤ B }
      *
-     *  @see    GLCM::main_angles_set(const cv::Mat&, const cv::Rect&, GLCM::Implementation, GLCM::Method, const GLCM::Range&, unsigned int)
+     *  @see    GLCM::main_angles_set(const cv::Mat&, const cv::Rect&, GLCM::Implementation, GLCM::Method, const GLCM::Range&, unsigned int, const GLCM::Options&)
      */
     DLL std::set<unsigned int> main_angles_set(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                                GLCM::Method meth, const cv::Range& range, unsigned int max_r = 0);
+                                                GLCM::Method meth, const cv::Range& range, unsigned int max_r = 0,
+                                                const GLCM::Options& options = GLCM::Options());
 #endif
 #endif
 
@@ -0,0 +1,81 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#pragma once
+#ifndef AIOLOS_INCREMENTAL_H
+#define AIOLOS_INCREMENTAL_H
+
+#include <vector>
+#include <cstdint>
+#include <opencv2/opencv.hpp>
+
+#include "GLCM.h"
+
+
+namespace GLCM {
+    /**
+     *  Calculates the dominant angle of consecutive frames of a mostly static video: the degree of concentration of
+     *  every (angle, radius) pair is stored per band of rows. Every frame gets compared to the previous one row by row,
+     *  only the bands containing a changed row (either the pixels themselves or their partners, the "halo") get
+     *  calculated again. Frames changing a few rows only cost about as much as these rows.
+     *
+     *  REVIEW: Z is a sum over every pixel pair => the bands add up exactly to the value of the whole frame, every
+     *          result equals GLCM::main_angle of the frame (DIFFERENCE engine, the same for every engine)
+     *  REVIEW: Frames get compared after being quantized / compacted => changes below the levels do not count
+     *  NOBUG:  Not supported: Scheme 1 (rotates the whole frame) and options.stable_radii (depend on every radius)
+     *  NOBUG:  Not thread-safe, every video needs an estimator of its own
+     */
+    class DLL IncrementalEstimator {
+    public:
+        /**
+         *  @param impl         which implementation of the GLCM shall be used (all but Scheme 1)
+         *  @param range        interval of angles to consider!
+         *  @param max_r        fixed maximum radius or, if not stated, one based on the frame boundaries
+         *  @param options      additional settings (e.g. levels every frame gets quantized to, the radius schedule)
+         *  @param band_height  number of rows of every band (smaller => less recalculated per change, more bands)
+         */
+        IncrementalEstimator(Implementation impl, const Range& range = Range(0, 179), unsigned int max_r = 0,
+                             const Options& options = Options(), int band_height = 16);
+
+
+        /**
+         *  Calculates the dominant angle of the next frame
+         *
+         *  @param image        the next frame (single channel, any size => a new size starts all over again)
+         *  @return             the dominant angle (in degrees!)
+         */
+        unsigned int update(const cv::Mat& image);
+
+
+        /**
+         *  Forgets the previous frame => the next frame gets calculated completely
+         */
+        void reset();
+
+
+        /// Distribution of the last frame (one value per angle of the range)
+        const std::vector<double>& distribution() const { return values; }
+
+        /// Fraction of (angle, radius, band) work items calculated again for the last frame (0 ... 1)
+        double recalculated() const { return last_recalculated; }
+
+    private:
+        Implementation impl;
+        Range range;
+        unsigned int max_r;
+        Options options;
+        int band_height;
+
+        cv::Mat previous;                   // previous frame (prepared)
+        std::vector<unsigned int> angles;
+        std::vector<unsigned int> radii;
+        std::vector<std::uint64_t> partial; // Z of every band (angles x radii x bands, one row per (angle, radius))
+        std::vector<double> values;
+        double last_recalculated = 0;
+    };
+}
+
+
+#endif //AIOLOS_INCREMENTAL_H
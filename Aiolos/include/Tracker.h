@@ -0,0 +1,92 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#pragma once
+#ifndef AIOLOS_TRACKER_H
+#define AIOLOS_TRACKER_H
+
+#include <opencv2/opencv.hpp>
+
+#include "GLCM.h"
+
+
+namespace GLCM {
+    /// Settings of GLCM::Tracker
+    struct TrackerOptions {
+        unsigned int window = 5;            // angles considered around the previous angle (±window, in degrees!)
+        unsigned int full_search = 30;      // every n-th frame searches the whole range (0 => only the first one)
+        double confidence_drop = 0.5;       // searches the whole range if the confidence drops below this fraction
+                                            // of the previous one
+    };
+
+
+    /**
+     *  Tracks the dominant angle of consecutive frames of a video: the orientation only changes slowly, so every frame
+     *  searches a window of ±k degrees around the angle of the previous frame instead of the whole range. The window
+     *  gets widened while the minimum lies on its edge, the whole range gets searched if the confidence drops or
+     *  periodically (every options.full_search frames).
+     *
+     *  REVIEW: Confidence := 1 - min / mean of the distribution inside ±window around the angle (comparable between
+     *          frames, independent of how many angles were actually searched)
+     *  REVIEW: The full range 0 ... 179 wraps around (179° and 0° are neighbours), every other range does not!
+     *  REVIEW: Every angle gets calculated at most once per frame, options.search gets ignored (windows are small)
+     *  NOBUG:  Not thread-safe, every video needs a tracker of its own
+     */
+    class DLL Tracker {
+    public:
+        /**
+         *  @param impl         which implementation of the GLCM shall be used
+         *  @param range        interval of angles to consider!
+         *  @param max_r        fixed maximum radius or, if not stated, one based on the frame boundaries
+         *  @param options      additional settings (e.g. levels every frame gets quantized to)
+         *  @param tracking     settings of the tracking (window, full search, confidence)
+         */
+        Tracker(Implementation impl, const Range& range = Range(0, 179), unsigned int max_r = 0,
+                const Options& options = Options(), const TrackerOptions& tracking = TrackerOptions());
+
+
+        /**
+         *  Calculates the dominant angle of the next frame
+         *
+         *  @param image        the next frame (single channel)
+         *  @return             the dominant angle (in degrees!)
+         */
+        unsigned int update(const cv::Mat& image);
+
+
+        /**
+         *  Forgets the previous frame => the next frame searches the whole range
+         */
+        void reset();
+
+
+        /// Confidence of the angle of the last frame (0 ... 1, 0 if there is none)
+        double confidence() const { return last_confidence; }
+
+        /// Whether the last frame searched the whole range
+        bool full_search() const { return searched_fully; }
+
+    private:
+        friend class VideoProcessor;
+
+        /// Same as Tracker::update for a frame already prepared (see GLCM::prepare_image)
+        unsigned int update_prepared(const cv::Mat& gray, int max_gray);
+
+        Implementation impl;
+        Range range;
+        unsigned int max_r;
+        Options options;
+        TrackerOptions tracking;
+
+        bool tracked = false;               // whether there is a previous angle
+        unsigned int angle = 0;             // angle of the previous frame
+        unsigned long frames = 0;           // frames since the last full search
+        double last_confidence = 0;
+        bool searched_fully = false;
+    };
+}
+
+
+#endif //AIOLOS_TRACKER_H
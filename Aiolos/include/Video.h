@@ -0,0 +1,114 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#pragma once
+#ifndef AIOLOS_VIDEO_H
+#define AIOLOS_VIDEO_H
+
+#include <string>
+#include <functional>
+#include <opencv2/opencv.hpp>
+
+#include "GLCM.h"
+#include "Tracker.h"
+
+
+namespace GLCM {
+    /// Result of a single frame of a video (see GLCM::VideoProcessor)
+    struct FrameResult {
+        unsigned long index = 0;        // number of the frame (starting with 0)
+        unsigned int angle = 0;         // the dominant angle (in degrees!)
+        double decode = 0;              // time spent decoding the frame (in ms)
+        double preprocess = 0;          // time spent converting to gray and quantizing the frame (in ms)
+        double estimate = 0;            // time spent calculating the dominant angle (in ms)
+        double latency = 0;             // time from starting to decode the frame until its result (in ms, incl. queues)
+        bool full_search = true;        // whether the whole range got searched (false if tracked, see GLCM::Tracker)
+    };
+
+
+    /// Summary of a processed video (average times per frame, in ms)
+    struct VideoStatistics {
+        unsigned long frames = 0;       // number of frames processed
+        double seconds = 0;             // time spent processing the whole video
+        double decode = 0;              // average time decoding a frame
+        double preprocess = 0;          // average time converting to gray and quantizing a frame
+        double estimate = 0;            // average time calculating the dominant angle of a frame
+        double latency = 0;             // average time from starting to decode a frame until its result
+    };
+
+
+    /**
+     *  Calculates the dominant angle of every frame of a video using a pipeline of three stages: decoding, converting
+     *  to gray + quantizing and the calculation itself. Every stage runs in a thread of its own (the calculation in the
+     *  calling one, using all threads of OpenMP), the stages are connected by bounded lock-free queues. Decoding and
+     *  preprocessing of the following frames therefore overlap with the calculation of the current one.
+     *
+     *  REVIEW: A stage waiting for a queue spins only briefly and blocks afterwards => a full queue (the calculation
+     *          being the bottleneck) does not take cores away from the OpenMP threads
+     */
+    class DLL VideoProcessor {
+    public:
+        /// Gets called with the result of every frame (in the order of the frames, by the calling thread)
+        typedef std::function<void(const FrameResult&)> Callback;
+
+        /// Returns the next frame of a video (false if there is none)
+        typedef std::function<bool(cv::Mat&)> Source;
+
+
+        /**
+         *  @param impl         which implementation of the GLCM shall be used
+         *  @param range        interval of angles to consider!
+         *  @param max_r        fixed maximum radius or, if not stated, one based on the frame boundaries
+         *  @param options      additional settings (e.g. levels every frame gets quantized to)
+         *  @param queue_size   number of frames every queue holds at most (bounds memory and latency)
+         */
+        VideoProcessor(Implementation impl, const Range& range = Range(0, 179), unsigned int max_r = 0,
+                        const Options& options = Options(), size_t queue_size = 4);
+
+
+        /**
+         *  Processes every frame of a video, returns once the last result got passed to the callback
+         *
+         *  @param capture      the opened video
+         *  @param callback     gets called with the result of every frame
+         *  @return             the summary of the video
+         */
+        VideoStatistics process(cv::VideoCapture& capture, const Callback& callback);
+
+
+        /**
+         *  Processes every frame returned by the given source, returns once the last result got passed to the callback
+         *
+         *  @param source       returns the frames (called by the decoding thread only)
+         *  @param callback     gets called with the result of every frame
+         *  @return             the summary of the video
+         *
+         *  REVIEW: An exception thrown by any stage stops the pipeline and gets rethrown by this function
+         */
+        VideoStatistics process(const Source& source, const Callback& callback);
+
+
+        /**
+         *  Every following video gets processed using a GLCM::Tracker: every frame only searches a window around the
+         *  angle of the previous one (see GLCM::Tracker for when the whole range gets searched)
+         *
+         *  @param tracking     settings of the tracking
+         */
+        void enable_tracking(const TrackerOptions& tracking = TrackerOptions());
+
+    private:
+        Implementation impl;
+        Range range;
+        unsigned int max_r;
+        Options options;
+        size_t queue_size;
+
+        bool tracked = false;
+        TrackerOptions tracking;
+    };
+}
+
+
+#endif //AIOLOS_VIDEO_H
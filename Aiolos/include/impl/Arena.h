@@ -0,0 +1,147 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#pragma once
+#ifndef AIOLOS_ARENA_H
+#define AIOLOS_ARENA_H
+
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <opencv2/opencv.hpp>
+
+#include "Sparse.h"
+
+
+namespace GLCM {
+    /**
+     *  Dense GLCM recording which of its rows got written, every kernel only writes through operator() => the rows
+     *  touched by a work item are known exactly (only its own band of the image, partners do not add rows)
+     *
+     *  @tparam C           count type of the GLCM: ushort, int (double only for huge images)
+     *
+     *  REVIEW: Same interface as cv::Mat_<C> as far as the kernels are concerned (rows, cols, operator())
+     *  REVIEW: One byte per row instead of the lowest/highest row => a single store per pair, no compares
+     */
+    template <typename C>
+    class TrackedGLCM {
+    public:
+        using value_type = C;
+
+        int rows = 0, cols = 0;
+
+        /// Count of the gray values i and j, row i gets marked as touched
+        C& operator()(int i, int j) {
+            touched[i] = 1;
+            return glcm(i, j);
+        }
+
+        /// Whether row y got written since the last reset
+        bool touched_row(int y) const {
+            return touched[y] != 0;
+        }
+
+        /// Row y of the underlying matrix
+        const C* operator[](int y) const {
+            return glcm[y];
+        }
+
+        /**
+         *  Zeroes the GLCM for the next work item, only the rows touched by the previous one get cleared (every
+         *  other row is still zero)
+         *
+         *  @param max_gray     size of the GLCM (number of gray levels)
+         */
+        void reset(int max_gray) {
+            if (rows != max_gray) {
+                glcm.create(max_gray, max_gray);
+                glcm.setTo(0);
+                touched.assign(max_gray, 0);
+                rows = cols = max_gray;
+                return;
+            }
+
+            for (int y = 0; y < rows; y++) {
+                if (!touched[y]) continue;
+
+                std::memset(glcm[y], 0, cols * sizeof(C));
+                touched[y] = 0;
+            }
+        }
+
+    private:
+        cv::Mat_<C> glcm;
+        std::vector<uchar> touched;         // rows written since the last reset (1 => written)
+    };
+
+
+    /**
+     *  Scratch GLCMs of a single thread: the matrix gets reset for the next work item instead of being freed, only
+     *  the rows actually written by the previous work item get zeroed (see GLCM::TrackedGLCM)
+     *
+     *  @tparam G           storage of the GLCM: cv::Mat_<C> or GLCM::SparseGLCM<C> (C: ushort, int, double)
+     */
+    template <typename G>
+    class GLCMArena;
+
+
+    template <typename C>
+    class GLCMArena<cv::Mat_<C>> {
+    public:
+        typedef TrackedGLCM<C> type;
+
+        /**
+         *  Returns the GLCM of the next work item, every cell is zero
+         *
+         *  @param max_gray     size of the GLCM (number of gray levels)
+         *  @return             the GLCM (valid until the next call of the same thread)
+         */
+        TrackedGLCM<C>& acquire(int max_gray) {
+            glcm.reset(max_gray);
+            return glcm;
+        }
+
+    private:
+        TrackedGLCM<C> glcm;
+    };
+
+
+    template <typename C>
+    class GLCMArena<SparseGLCM<C>> {
+    public:
+        typedef SparseGLCM<C> type;
+
+        /// Returns the (empty) GLCM of the next work item, the buckets of the previous one are kept
+        SparseGLCM<C>& acquire(int max_gray) {
+            if (!glcm || glcm->rows != max_gray) glcm.reset(new SparseGLCM<C>(max_gray, max_gray));
+            else glcm->clear();
+
+            return *glcm;
+        }
+
+    private:
+        std::unique_ptr<SparseGLCM<C>> glcm;
+    };
+
+
+    /**
+     *  Returns the scratch GLCM of the calling thread for the next work item (see GLCM::GLCMArena)
+     *
+     *  @tparam G           storage of the GLCM: cv::Mat_<C> or GLCM::SparseGLCM<C> (C: ushort, int, double)
+     *  @param max_gray     size of the GLCM (number of gray levels)
+     *  @return             the GLCM (valid until the next call of the same thread)
+     *
+     *  REVIEW: One arena per thread and storage type, lives as long as the thread (OpenMP keeps its threads)
+     *  NOBUG:  A single GLCM per thread => must not be nested (e.g. by GLCM::Privatized::GLCM inside a work item)
+     */
+    template <typename G>
+    typename GLCMArena<G>::type& arena_glcm(int max_gray) {
+        static thread_local GLCMArena<G> arena;
+        return arena.acquire(max_gray);
+    }
+}
+
+
+#endif //AIOLOS_ARENA_H
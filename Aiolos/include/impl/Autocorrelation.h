@@ -0,0 +1,106 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#pragma once
+#ifndef AIOLOS_AUTOCORRELATION_H
+#define AIOLOS_AUTOCORRELATION_H
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+#include "Offsets.h"
+
+
+namespace GLCM {
+    namespace Autocorrelation {
+        /// Largest number of gray levels calculated exactly (errors of the DFT grow with the squared gray values)
+        constexpr int MAX_GRAY_LEVELS = 256;
+
+
+        /**
+         *  Calculates the degree of concentration of every (angle, radius) pair using the standard GLCM. For every
+         *  integer offset (dx, dy) the degree of concentration equals
+         *
+         *      Z(dx, dy) = Σ a^2 + Σ b^2 - 2 * Σ a*b
+         *
+         *  over all pairs (a, b) inside the image. Both squared sums are taken from an integral image of I^2, the sum
+         *  of the products is the autocorrelation of the image, calculated once for every offset using the DFT.
+         *
+         *  @param image                    the given image (single channel, at most MAX_GRAY_LEVELS gray levels)
+         *  @param values                   the returned values (angles.size() x radii.size(), one row per angle)
+         *  @param radii                    the radii, a value shall be calculated for
+         *  @param angles                   the angles, a value shall be calculated for (in degrees!)
+         *
+         *  REVIEW: Offsets equal the ones used by GLCM::Standard::GLCM (same cached table, see GLCM::offset_table)!
+         *  NOBUG:  Exact for 8 bit gray values only: the error of the DFT grows with the squared gray values and
+         *          exceeds 0.5 for deeper images => GLCM::calc_angle_dist uses DIFFERENCE for them instead
+         */
+        inline void calc_values(const cv::Mat& image, std::vector<double>& values, const std::vector<unsigned int>& radii,
+                                 const std::vector<unsigned int>& angles) {
+            int rows = image.rows, cols = image.cols;
+            unsigned int max_radius = radii.empty() ? 0 : *std::max_element(radii.begin(), radii.end());
+
+            // Offsets reaching over the image boundaries have no pairs at all => no padding needed for them
+            int pad_x = std::min<int>(max_radius, cols - 1);
+            int pad_y = std::min<int>(max_radius, rows - 1);
+
+            cv::Mat1d gray;
+            image.convertTo(gray, CV_64F);
+
+            // Zero padding prevents the circular correlation from wrapping around for every offset considered
+            cv::Mat1d padded;
+            cv::copyMakeBorder(gray, padded, 0, cv::getOptimalDFTSize(rows + pad_y) - rows,
+                               0, cv::getOptimalDFTSize(cols + pad_x) - cols, cv::BORDER_CONSTANT, cv::Scalar(0));
+
+            // Autocorrelation: IDFT(F * conj(F))
+            cv::Mat spectrum;
+            cv::dft(padded, spectrum, cv::DFT_COMPLEX_OUTPUT);
+            cv::mulSpectrums(spectrum, spectrum, spectrum, 0, true);
+
+            cv::Mat1d correlation;
+            cv::dft(spectrum, correlation, cv::DFT_INVERSE | cv::DFT_SCALE | cv::DFT_REAL_OUTPUT);
+
+            // Integral image of I^2 to get the squared sums of every overlap in O(1)
+            cv::Mat sum, sqsum;
+            cv::integral(gray, sum, sqsum, CV_64F, CV_64F);
+            const cv::Mat1d squares = sqsum;
+
+            auto squared_sum = [&squares](int x0, int y0, int x1, int y1) {
+                return squares(y1, x1) - squares(y0, x1) - squares(y1, x0) + squares(y0, x0);
+            };
+
+            values.assign(angles.size() * radii.size(), 0.0);
+            std::shared_ptr<const OffsetTable> offsets = offset_table(angles, radii);
+
+            #pragma omp parallel for
+            for (unsigned int theta = 0; theta < angles.size(); theta++) {
+                for (unsigned int i = 0; i < radii.size(); i++) {
+                    int dist_x = (*offsets)[theta * radii.size() + i].dist_x;
+                    int dist_y = (*offsets)[theta * radii.size() + i].dist_y;
+                    if (std::abs(dist_x) >= cols || std::abs(dist_y) >= rows) continue;
+
+                    // Pixels whose partner lies inside the image as well
+                    int x0 = std::max(0, -dist_x), x1 = std::min(cols, cols - dist_x);
+                    int y0 = std::max(0, -dist_y), y1 = std::min(rows, rows - dist_y);
+
+                    // Autocorrelation is symmetric, negative offsets are found at the end of each dimension
+                    double products = correlation((dist_y + correlation.rows) % correlation.rows,
+                                                  (dist_x + correlation.cols) % correlation.cols);
+
+                    // Every Z is an integer, rounding removes the DFT's numerical noise (below 0.5 for 8 bit only)
+                    values[theta * radii.size() + i] = std::round(squared_sum(x0, y0, x1, y1)
+                                                                  + squared_sum(x0 + dist_x, y0 + dist_y,
+                                                                                x1 + dist_x, y1 + dist_y)
+                                                                  - 2 * products);
+                }
+            }
+        }
+    }
+}
+
+
+#endif //AIOLOS_AUTOCORRELATION_H
@@ -0,0 +1,190 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#pragma once
+#ifndef AIOLOS_BATCH_H
+#define AIOLOS_BATCH_H
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <type_traits>
+
+#include "Distribution.h"
+
+
+namespace GLCM {
+    namespace Batch {
+        /// Work of a single item of a batch, its units get calculated by one parallel region shared by all items
+        struct Job {
+            long units = 0;                         // number of independent work items
+            std::function<void(long)> unit;         // calculates a single work item (called in parallel)
+            std::function<void()> alone;            // whole item calculated after the shared region (if set)
+            std::function<void()> finish;           // combines the work items afterwards (called sequentially)
+        };
+
+
+        /**
+         *  Creates the job calling the given function once (for items which cannot be split into work items)
+         *
+         *  @param options                  additional settings of the item
+         *  @param function                 the function called once (with the options of the item)
+         *  @return                         the job
+         *
+         *  REVIEW: No units => called after the shared region as a call of its own, using every thread of its own
+         *          parallel regions (inside of the shared region it would run on a single thread)
+         */
+        inline Job single_job(const Options& options, const std::function<void(const Options&)>& function) {
+            Job job;
+            job.alone = [=]() { function(options); };
+            job.finish = []() {};
+
+            return job;
+        }
+
+
+        /**
+         *  Creates the job calculating the distribution of an image for the given angles, every (angle, radius) pair
+         *  is a unit of its own (every angle using Scheme 1, because all its radii share one rotation, unless there
+         *  are fewer angles than threads)
+         *
+         *  @param image                    the given image
+         *  @param impl                     which implementation of the GLCM shall be used
+         *  @param max_radius               the given maximum radius (upper bound of the radius schedule)
+         *  @param angles                   the angles, which shall be considered (any order)
+         *  @param options                  additional settings (e.g. which engine calculates Z)
+         *  @param distribution             the returned distribution (size: angles.size(), filled by finish)
+         *  @return                         the job
+         *
+         *  REVIEW: Everything not made of independent (angle, radius) pairs (AUTOCORRELATION, tiles, adaptive
+         *          schedules) becomes a single job calling GLCM::getAngleDistribution instead!
+         */
+        inline Job distribution_job(const cv::Mat& image, Implementation impl, unsigned int max_radius,
+                                     const std::vector<unsigned int>& angles, const Options& options,
+                                     std::vector<double>& distribution) {
+            distribution.assign(angles.size(), 0.0);
+
+            if (options.engine == AUTOCORRELATION || options.tile_size != 0 || options.stable_radii != 0) {
+                return single_job(options, [=, &distribution](const Options& unit_options) {
+                    distribution = getAngleDistribution(image, impl, max_radius, angles, unit_options);
+                });
+            }
+
+            Job job;
+            auto radii = std::make_shared<std::vector<unsigned int>>(radius_schedule(max_radius, options));
+            auto values = std::make_shared<std::vector<double>>(angles.size() * radii->size(), 0.0);
+            auto offsets = offset_table(angles, *radii);
+            long n_angles = static_cast<long>(angles.size()), n_radii = static_cast<long>(radii->size());
+
+            int max_gray = 0;
+            cv::Mat gray = prepare_image(image, options, max_gray);
+
+            with_image_type(gray, [&](const auto& typed) {
+                typedef typename std::decay<decltype(typed)>::type::value_type T;
+                cv::Mat_<T> prepared = typed;
+
+                with_storage(prepared, options, max_gray, [&](auto storage) {
+                    typedef typename decltype(storage)::type G;
+
+                    if (impl == SCHEME1 && n_angles >= omp_get_max_threads()) {
+                        job.units = n_angles;
+                        job.unit = [=](long theta) {
+                            Scheme1::Rotation<T> rotation;
+                            Scheme1::rotate(prepared, angles[theta] * CV_PI / 180, rotation);
+
+                            for (long i = 0; i < n_radii; i++) {
+                                (*values)[theta * n_radii + i] = calc_rotated_degree<G>(
+                                        rotation, options.engine, max_gray, static_cast<int>((*radii)[i]));
+                            }
+                        };
+                    } else if (impl == SCHEME1) {
+                        // Too few angles to keep every thread busy: the first unit of an angle rotates the image, the
+                        // units iterate over the angles first => all of them get rotated in parallel before any radius
+                        auto rotations = std::make_shared<std::vector<Scheme1::Rotation<T>>>(n_angles);
+                        auto rotated = std::make_shared<std::vector<std::once_flag>>(n_angles);
+
+                        job.units = static_cast<long>(values->size());
+                        job.unit = [=](long unit) {
+                            long theta = unit % n_angles, i = unit / n_angles;
+
+                            std::call_once((*rotated)[theta], [&]() {
+                                Scheme1::rotate(prepared, angles[theta] * CV_PI / 180, (*rotations)[theta]);
+                            });
+
+                            (*values)[theta * n_radii + i] = calc_rotated_degree<G>(
+                                    (*rotations)[theta], options.engine, max_gray, static_cast<int>((*radii)[i]));
+                        };
+                    } else {
+                        job.units = static_cast<long>(values->size());
+                        job.unit = [=](long pair) {
+                            (*values)[pair] = calc_concentration_degree<G>(prepared, impl, options.engine, max_gray,
+                                                                           (*offsets)[pair], cv::Range::all());
+                        };
+                    }
+                });
+            });
+
+            // Exact sums (see GLCM::exact_sum) => same distribution as GLCM::calc_angle_dist
+            job.finish = [=, &distribution]() {
+                for (size_t theta = 0; theta < distribution.size(); theta++) {
+                    auto first = values->begin() + theta * n_radii;
+                    distribution[theta] = exact_sum(first, first + n_radii);
+                }
+
+                if (options.statistics != nullptr) {
+                    options.statistics->angles += angles.size();
+                    options.statistics->radii += radii->size();
+                }
+            };
+
+            return job;
+        }
+
+
+        /**
+         *  Calculates every unit of every job using one parallel region, afterwards every job gets finished in order
+         *
+         *  @param jobs                     the jobs of the batch
+         *
+         *  REVIEW: Single jobs (opening parallel regions themselves) run one after another after the shared region
+         *  REVIEW: Exceptions must not leave the parallel region => the first one gets rethrown afterwards
+         */
+        inline void run(std::vector<Job>& jobs) {
+            // first[i] := index of the first unit of job i => every unit finds its job using a binary search
+            std::vector<long> first(jobs.size() + 1, 0);
+            for (size_t i = 0; i < jobs.size(); i++) first[i + 1] = first[i] + jobs[i].units;
+
+            std::exception_ptr error;
+
+            #pragma omp parallel for schedule(dynamic)
+            for (long unit = 0; unit < first.back(); unit++) {
+                size_t job = std::distance(first.begin(), std::upper_bound(first.begin(), first.end(), unit)) - 1;
+
+                try {
+                    jobs[job].unit(unit - first[job]);
+                } catch (...) {
+                    #pragma omp critical
+                    {
+                        if (!error) error = std::current_exception();
+                    };
+                }
+            }
+
+            if (error) std::rethrow_exception(error);
+
+            for (Job& job : jobs) {
+                if (job.alone) job.alone();
+            }
+
+            for (Job& job : jobs) job.finish();
+        }
+    }
+}
+
+
+#endif //AIOLOS_BATCH_H
@@ -7,6 +7,8 @@
 #ifndef AIOLOS_DEFINITIONS_H
 #define AIOLOS_DEFINITIONS_H
 
+#include <atomic>
+
 
 namespace GLCM {
     /// Type alias for the range type
@@ -25,7 +27,101 @@ namespace GLCM {
         STANDARD = 0,                   // Standard implementation => some values exist and some do not
         SCHEME1,                        // Scheme 1 => image gets rotated
         SCHEME2,                        // Scheme 2 => interpolation of nearby points
-        SCHEME3                         // Scheme 3 => interpolation and summary (?)
+        SCHEME3                         // Scheme 3 => interpolation of nearby points (rounded once)
+    };
+
+
+    /// Engine used to calculate the degree of concentration Z(θ,r), independent of the implementation!
+    enum Engine {
+        MATRIX = 0,                     // every GLCM gets created and walked afterwards (as described in the paper)
+        DIFFERENCE,                     // squared gray value differences of every pair get summed up, no GLCM needed
+        AUTOCORRELATION                 // every offset at once using the autocorrelation (STANDARD implementation only!,
+                                        // images of more than 256 gray levels use DIFFERENCE instead)
+    };
+
+
+    /// How the angles of a range get searched for the dominant one (used by GLCM::main_angle)
+    enum Search {
+        FULL = 0,                       // every angle of the range gets evaluated (as described in the paper)
+        COARSE_TO_FINE,                 // coarse sampling of the range, refined around the best candidates
+        PYRAMID                         // whole range on the smallest level of an image pyramid, refined around the
+                                        // best candidates on every finer level
+    };
+
+
+    /// Which radii up to the maximum radius get summed up for every angle
+    enum Schedule {
+        EVERY_RADIUS = 0,               // 1, 2, ..., max_r (as described in the paper)
+        STRIDE,                         // 1, 1 + stride, 1 + 2*stride, ... up to max_r
+        GEOMETRIC,                      // 1, round(factor), round(factor^2), ... up to max_r
+        EXPLICIT                        // the given list of radii (max_r gets ignored)
+    };
+
+
+    /**
+     *  Counters describing the work done by a calculation (optional output, see GLCM::Options)
+     *
+     *  REVIEW: Atomic => copies of the options share the counters and may be used by concurrent calls
+     */
+    struct Statistics {
+        std::atomic<unsigned long> angles{0}; // number of angles, whose degree of concentration got calculated
+        std::atomic<unsigned long> radii{0};  // number of radii summed up (less than scheduled when stopped early)
+    };
+
+
+    /// Additional settings for the calculation, default values equal the behaviour described in the paper
+    struct Options {
+        Engine engine = MATRIX;         // which engine calculates the degree of concentration
+        unsigned int levels = 0;        // number of gray levels the image gets quantized to (power of 2, 0 => none)
+
+        Search search = FULL;           // how the angles get searched for the dominant one
+        std::vector<unsigned int>       // step sizes of the coarse-to-fine search (in degrees, descending, ends in 1)
+                steps = {10, 3, 1};
+        unsigned int candidates = 2;    // number of best angles, every round of the search refines around
+        unsigned int pyramid_levels = 3; // number of levels below the full resolution (PYRAMID only)
+        unsigned int refinement = 3;    // angles considered around every candidate on finer levels (±, PYRAMID only)
+
+        Schedule schedule = EVERY_RADIUS; // which radii get summed up for every angle
+        unsigned int stride = 2;        // distance of two radii (STRIDE only)
+        double factor = 2.0;            // ratio of two radii (GEOMETRIC only, > 1)
+        std::vector<unsigned int> radii; // the radii (EXPLICIT only)
+        unsigned int stable_radii = 0;  // stop once the dominant angle did not change for this many radii (0 => never)
+
+        unsigned int tile_size = 0;     // edge length of the tiles evaluated for all pairs at once (DIFFERENCE only,
+                                        // ignored by Scheme 1, 0 => none)
+
+        Statistics* statistics = nullptr; // counters get added to it (if set)
+    };
+
+
+    /// Haralick statistics of a GLCM, combinable as flags (see GLCM::texture_features)
+    enum TextureFeature {
+        CONTRAST = 1,                   // Σ (i-j)^2 p(i,j) (the degree of concentration, normalized)
+        ENERGY = 2,                     // Σ p(i,j)^2 (angular second moment)
+        ENTROPY = 4,                    // -Σ p(i,j) ln p(i,j)
+        HOMOGENEITY = 8,                // Σ p(i,j) / (1 + (i-j)^2) (inverse difference moment)
+        CORRELATION = 16,               // Σ (i-μ_i)(j-μ_j) p(i,j) / (σ_i σ_j), 1 if either deviation is 0
+        ALL_TEXTURE_FEATURES = 31
+    };
+
+
+    /// Haralick statistics of a single GLCM (normalized to probabilities), only the requested ones get calculated
+    struct TextureFeatures {
+        double contrast = 0;
+        double energy = 0;
+        double entropy = 0;
+        double homogeneity = 0;
+        double correlation = 0;
+    };
+
+
+    /// Result of GLCM::texture_features
+    struct TextureFeatureMap {
+        std::vector<unsigned int> angles;   // the angles (in degrees!)
+        std::vector<unsigned int> radii;    // the radii of the schedule
+        std::vector<TextureFeatures>        // features of every (angle, radius) pair (one row per angle)
+                features;
+        std::vector<double> distribution;   // degree of concentration of every angle (see GLCM::main_angle)
     };
 
 
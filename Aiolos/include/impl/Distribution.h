@@ -7,9 +7,16 @@
 #ifndef AIOLOS_DISTRIBUTION_H
 #define AIOLOS_DISTRIBUTION_H
 
+#include <limits>
+#include <cstdint>
+#include <numeric>
+
 #include "Scheme1.h"
 #include "Scheme2.h"
 #include "Scheme3.h"
+#include "Autocorrelation.h"
+#include "Offsets.h"
+#include "Arena.h"
 
 
 /**
@@ -19,26 +26,81 @@
 
 
 namespace GLCM {
+    /// Largest number of gray levels stored in a dense GLCM (4 MB using int counts), sparse GLCMs are used above
+    constexpr int MAX_DENSE_GRAY_LEVELS = 1024;
+
+
+    /**
+     *  Sums up degrees of concentration of parts (bands, tiles, radii) exactly
+     *
+     *  @tparam It          iterator over the values (doubles holding integers)
+     *  @param first        first value
+     *  @param last         behind the last value
+     *  @return             the sum (converted to double only once)
+     *
+     *  REVIEW: Every Z is an integer => summed up as std::uint64_t, the same sum for any order or split of the parts
+     *          (summing up doubles rounds once the sum exceeds 2^53, depending on the order)
+     */
+    template <typename It>
+    double exact_sum(It first, It last) {
+        std::uint64_t sum = 0;
+        for (; first != last; ++first) sum += static_cast<std::uint64_t>(*first);
+
+        return static_cast<double>(sum);
+    }
+
+
     /**
      *  Calculates the degree of concentration of a GLCM (equals the Z-function from the paper)
      *
+     *  @tparam C           count type of the GLCM: ushort, int (double only for huge images)
      *  @param glcm         the GLCM, to work on
      *  @return             the degree of concentration
      *
      *  NOBUG: Do not change x/y to unsigned => would break everything!
      *  REVIEW: Usage does not depend on specific Mat-Type (CT nor RT)
+     *  REVIEW: Runs inside the work items of GLCM::calc_angle_dist => no parallel region of its own!
+     *  REVIEW: Counts are integers => exact integer arithmetic, converted to double only once at the end
      */
-    double concentration_degree(const cv::Mat1d& glcm) {
-        double value = 0;
+    template <typename C>
+    double concentration_degree(const cv::Mat_<C>& glcm) {
+        std::uint64_t value = 0;
 
-        #pragma omp parallel for collapse(2) reduction(+:value)
-        for (int x = 0; x < glcm.cols; x++) {
-            for (int y = 0; y < glcm.rows; y++) {
-                value += ( pow((y+1)-(x+1), 2) * glcm(y, x) );
+        for (int y = 0; y < glcm.rows; y++) {
+            const C* row = glcm[y];
+
+            for (int x = 0; x < glcm.cols; x++) {
+                std::uint64_t diff = static_cast<std::uint64_t>(std::abs((y+1)-(x+1)));
+                value += diff * diff * static_cast<std::uint64_t>(row[x]);
             }
         }
 
-        return value;
+        return static_cast<double>(value);
+    }
+
+
+    /**
+     *  Calculates the degree of concentration of a GLCM of the arena, only the rows written get walked
+     *
+     *  @tparam C           count type of the GLCM: ushort, int (double only for huge images)
+     *  @param glcm         the GLCM, to work on
+     *  @return             the degree of concentration
+     */
+    template <typename C>
+    double concentration_degree(const TrackedGLCM<C>& glcm) {
+        std::uint64_t value = 0;
+
+        for (int y = 0; y < glcm.rows; y++) {
+            if (!glcm.touched_row(y)) continue;
+            const C* row = glcm[y];
+
+            for (int x = 0; x < glcm.cols; x++) {
+                std::uint64_t diff = static_cast<std::uint64_t>(std::abs(y - x));
+                value += diff * diff * static_cast<std::uint64_t>(row[x]);
+            }
+        }
+
+        return static_cast<double>(value);
     }
 
 
@@ -67,95 +129,633 @@ namespace GLCM {
 
 
     /**
-     *  Calculates values for all the given angles of Z(cv::Mat1d&) (equals the Z'-function from the paper)
+     *  Creates the GLCM of a single work item (angle, radius and band of rows) in the given storage
      *
+     *  @tparam G                       storage of the GLCM: cv::Mat_<C> or SparseGLCM<C>
      *  @tparam T                       single channel type: char/uchar, short/ushort, int
      *  @param image                    the given image
-     *  @param angle_distribution       all possible orientation angles
      *  @param impl                     which implementation of the GLCM shall be used
-     *  @param max_radius               the given maximum radius
-     *  @param begin                    the lowest angle, a GLCM shall be calculated for
+     *  @param glcm                     the storage of the GLCM (max_gray x max_gray, has to be zeroed already!)
+     *  @param offset                   the offset (and weights) of the radius and angle, the GLCM is based on
+     *  @param rows                     the band of rows, whose pixels (and their partners) are considered
      */
-    template <typename T>
-    void calc_angle_dist(const cv::Mat_<T>& image, std::vector<double>& angle_distribution, Implementation impl,
-                          unsigned int max_radius, unsigned int begin) {
-        int max_gray = Util::max_gray_value(image);
-
-        // Outer loop beginning with range.first, ending after range.second
-        #pragma omp parallel for shared(max_gray)
-        for (unsigned int theta = 0; theta < angle_distribution.size(); theta++) {
-            double theta_rad = (begin + theta) * CV_PI / 180;
-            double value = 0.0;
-
-            #pragma omp parallel for shared(max_gray, theta_rad) reduction(+:value)
-            for (unsigned int r = 1; r <= max_radius; r++) {
-                cv::Mat1d glcm(max_gray, max_gray, 0.0);
-
-                // Which implementation of the paper shall be used!
-                switch (impl) {
-                    case SCHEME1:
-                        Scheme1::GLCM(image, glcm, r, theta_rad);
-                        break;
-                    case SCHEME2:
-                        Scheme2::GLCM(image, glcm, r, theta_rad);
-                        break;
-                    case SCHEME3:
-                        Scheme3::GLCM(image, glcm, r, theta_rad);
-                        break;
-                    case STANDARD:
-                        Standard::GLCM(image, glcm, r, theta_rad);
+    template <typename G, typename T>
+    void create_glcm(const cv::Mat_<T>& image, Implementation impl, G& glcm, const Offset& offset,
+                     const cv::Range& rows) {
+        // Which implementation of the paper shall be used!
+        switch (impl) {
+            case SCHEME1:
+                Scheme1::GLCM(image, glcm, offset, rows);
+                break;
+            case SCHEME2:
+                Scheme2::GLCM(image, glcm, offset, rows);
+                break;
+            case SCHEME3:
+                Scheme3::GLCM(image, glcm, offset, rows);
+                break;
+            case STANDARD:
+                Standard::GLCM(image, glcm, offset, rows);
+        }
+    }
+
+
+    /**
+     *  Calculates the degree of concentration for a single work item (angle, radius and band of rows) by creating its
+     *  GLCM in the given storage
+     *
+     *  @tparam G                       storage of the GLCM: cv::Mat_<C> or SparseGLCM<C>
+     *  @tparam T                       single channel type: char/uchar, short/ushort, int
+     *  @param image                    the given image
+     *  @param impl                     which implementation of the GLCM shall be used
+     *  @param glcm                     the storage of the GLCM (max_gray x max_gray, has to be zeroed already!)
+     *  @param offset                   the offset (and weights) of the radius and angle, the GLCM is based on
+     *  @param rows                     the band of rows, whose pixels (and their partners) are considered
+     *  @return                         the degree of concentration
+     */
+    template <typename G, typename T>
+    double glcm_concentration_degree(const cv::Mat_<T>& image, Implementation impl, G& glcm, const Offset& offset,
+                                      const cv::Range& rows) {
+        create_glcm(image, impl, glcm, offset, rows);
+        return concentration_degree(glcm);
+    }
+
+
+    /**
+     *  Calculates the degree of concentration for a single work item (angle, radius and band of rows / tile)
+     *
+     *  @tparam G                       storage of the GLCM: cv::Mat_<C> or SparseGLCM<C> (only used by the MATRIX engine)
+     *  @tparam T                       single channel type: char/uchar, short/ushort, int
+     *  @param image                    the given image
+     *  @param impl                     which implementation of the GLCM shall be used
+     *  @param engine                   which engine calculates the degree of concentration
+     *  @param max_gray                 size of the GLCM (only used by the MATRIX engine)
+     *  @param offset                   the offset (and weights) of the radius and angle, the GLCM is based on
+     *  @param rows                     the band of rows, whose pixels (and their partners) are considered
+     *  @param cols                     the band of columns, whose pixels (and their partners) are considered
+     *                                  (DIFFERENCE only, every GLCM considers all columns)
+     *  @return                         the degree of concentration
+     *
+     *  REVIEW: The GLCM comes from the arena of the thread (see GLCM::arena_glcm), only the rows written by the
+     *          previous work item get zeroed
+     */
+    template <typename G, typename T>
+    double calc_concentration_degree(const cv::Mat_<T>& image, Implementation impl, Engine engine, int max_gray,
+                                      const Offset& offset, const cv::Range& rows,
+                                      const cv::Range& cols = cv::Range::all()) {
+        if (engine == DIFFERENCE) {
+            // Z gets calculated directly, no GLCM is created
+            switch (impl) {
+                case SCHEME1:
+                    return Scheme1::concentration_degree(image, offset, rows, cols);
+                case SCHEME2:
+                    return Scheme2::concentration_degree(image, offset, rows, cols);
+                case SCHEME3:
+                    return Scheme3::concentration_degree(image, offset, rows, cols);
+                case STANDARD:
+                    return Standard::concentration_degree(image, offset, rows, cols);
+            }
+        }
+
+        return glcm_concentration_degree(image, impl, arena_glcm<G>(max_gray), offset, rows);
+    }
+
+
+    /**
+     *  Calculates the degree of concentration for a single work item of Scheme 1 (radius and band of rows of an image
+     *  rotated already)
+     *
+     *  @tparam G                       storage of the GLCM: cv::Mat_<C> or SparseGLCM<C> (only used by the MATRIX engine)
+     *  @tparam T                       single channel type: char/uchar, short/ushort, int
+     *  @param rotation                 the rotated image
+     *  @param engine                   which engine calculates the degree of concentration
+     *  @param max_gray                 size of the GLCM (only used by the MATRIX engine)
+     *  @param r                        the radius, the GLCM is based on
+     *  @param rows                     the band of rows (of the rotated image), whose pixels are considered
+     *  @return                         the degree of concentration
+     */
+    template <typename G, typename T>
+    double calc_rotated_degree(const Scheme1::Rotation<T>& rotation, Engine engine, int max_gray, int r,
+                                const cv::Range& rows = cv::Range::all()) {
+        if (engine == DIFFERENCE) return Scheme1::concentration_degree(rotation, r, rows);
+
+        auto& glcm = arena_glcm<G>(max_gray);
+        Scheme1::GLCM(rotation, glcm, r, rows);
+        return concentration_degree(glcm);
+    }
+
+
+    /**
+     *  Calculates into how many bands of rows every (angle, radius) pair gets split, so that there are enough work
+     *  items for dynamic load balancing
+     *
+     *  @param pairs                    number of (angle, radius) pairs
+     *  @param rows                     number of rows of the image (upper bound of the bands)
+     *  @param threads                  number of threads sharing the work items
+     *  @return                         the number of bands (at least 1)
+     */
+    inline int band_count(long pairs, int rows, int threads) {
+        long wanted = 4L * threads;
+        if (pairs == 0) return 1;
+
+        return static_cast<int>(std::max(1L, std::min<long>(rows, (wanted + pairs - 1) / pairs)));
+    }
+
+
+    /**
+     *  Calculates the degree of concentration of every (angle, radius) pair
+     *
+     *  Every (angle, radius) pair is a work item of its own, all of them are distributed dynamically over one flat
+     *  parallel region (the cost of an item depends on the radius because of the image boundaries). When there are
+     *  too few items to keep every thread busy the image gets split into bands of rows as well. Z is linear in the
+     *  pairs counted, so the values of the bands just add up (every engine, the MATRIX engine creates one GLCM per
+     *  band in the arena of its thread, no merged GLCM needed).
+     *
+     *  Using the DIFFERENCE engine and a tile size the image gets split into tiles instead, every tile evaluates all
+     *  pairs at once while it is cached (instead of streaming the whole image once per pair).
+     *
+     *  Scheme 1 works on angles instead: every angle rotates the image once, every radius of it uses that rotation.
+     *  With fewer angles than threads all angles get rotated first, afterwards every (angle, radius) pair and band of
+     *  rotated rows is a work item of its own (the tile size is ignored).
+     *
+     *  @tparam G                       storage of the GLCM: cv::Mat_<C> or SparseGLCM<C> (only used by the MATRIX engine)
+     *  @tparam T                       single channel type: char/uchar, short/ushort, int
+     *  @param image                    the given image
+     *  @param values                   the returned values (angles.size() x radii.size(), one row per angle)
+     *  @param impl                     which implementation of the GLCM shall be used
+     *  @param radii                    the radii, a GLCM shall be calculated for
+     *  @param angles                   the angles, a GLCM shall be calculated for (in degrees!)
+     *  @param options                  additional settings (e.g. which engine calculates Z)
+     *  @param max_gray                 number of gray levels of the image (size of the GLCM)
+     */
+    template <typename G, typename T>
+    void calc_values_impl(const cv::Mat_<T>& image, std::vector<double>& values, Implementation impl,
+                           const std::vector<unsigned int>& radii, const std::vector<unsigned int>& angles,
+                           const Options& options, int max_gray) {
+        // Enough work items for dynamic load balancing, otherwise split into bands of rows
+        long n_angles = static_cast<long>(angles.size()), n_radii = static_cast<long>(radii.size());
+        long pairs = n_angles * n_radii;
+        int bands = band_count(pairs, image.rows, omp_get_max_threads());
+        int band_height = (image.rows + bands - 1) / bands;
+
+        values.assign(pairs, 0.0);
+
+        // Same layout as the values (one row per angle), no trigonometry left inside the work items
+        std::shared_ptr<const OffsetTable> offsets = offset_table(angles, radii);
+
+        if (impl == SCHEME1 && n_angles >= omp_get_max_threads()) {
+            // Every angle rotates the image once (buffer reused by the thread), all its radii work on that rotation
+            #pragma omp parallel
+            {
+                Scheme1::Rotation<T> rotation;
+
+                #pragma omp for schedule(dynamic)
+                for (long theta = 0; theta < n_angles; theta++) {
+                    Scheme1::rotate(image, angles[theta] * CV_PI / 180, rotation);
+
+                    for (long i = 0; i < n_radii; i++) {
+                        values[theta * n_radii + i] = calc_rotated_degree<G>(rotation, options.engine, max_gray,
+                                                                             static_cast<int>(radii[i]));
+                    }
                 }
+            }
 
-                value += concentration_degree(glcm);
+            return;
+        }
+
+        if (impl == SCHEME1) {
+            // Too few angles to keep every thread busy: all of them get rotated first, afterwards every (angle, radius)
+            // pair and band of rotated rows is a work item of its own
+            std::vector<Scheme1::Rotation<T>> rotations(n_angles);
+
+            #pragma omp parallel for schedule(dynamic)
+            for (long theta = 0; theta < n_angles; theta++) {
+                Scheme1::rotate(image, angles[theta] * CV_PI / 180, rotations[theta]);
+            }
+
+            int side = Scheme1::rotated_side(image.size());
+            int rotated_bands = band_count(pairs, side, omp_get_max_threads());
+            int rotated_height = (side + rotated_bands - 1) / rotated_bands;
+
+            long items = pairs * rotated_bands;
+            std::vector<double> band_values(items, 0.0);
+
+            #pragma omp parallel for schedule(dynamic)
+            for (long item = 0; item < items; item++) {
+                long pair = item / rotated_bands;
+                int band = item % rotated_bands;
+                cv::Range rows(band * rotated_height, std::min(side, (band + 1) * rotated_height));
+
+                band_values[item] = calc_rotated_degree<G>(rotations[pair / n_radii], options.engine, max_gray,
+                                                           static_cast<int>(radii[pair % n_radii]), rows);
+            }
+
+            // Exact sum of the bands => same result as a single work item per angle
+            for (long pair = 0; pair < pairs; pair++) {
+                auto first = band_values.begin() + pair * rotated_bands;
+                values[pair] = exact_sum(first, first + rotated_bands);
+            }
+
+            return;
+        }
+
+        if (options.engine == DIFFERENCE && options.tile_size != 0) {
+            // Tiles are the work items: every (angle, radius) pair gets evaluated while the tile (+ halo) is cached
+            int tile = static_cast<int>(options.tile_size);
+            int tiles_x = (image.cols + tile - 1) / tile;
+            long tiles = static_cast<long>((image.rows + tile - 1) / tile) * tiles_x;
+
+            // Every Z is an integer => partial sums of the threads as std::uint64_t, exact for any order of the tiles
+            std::vector<std::vector<std::uint64_t>> partial(omp_get_max_threads(), std::vector<std::uint64_t>(pairs, 0));
+
+            #pragma omp parallel for schedule(dynamic)
+            for (long t = 0; t < tiles; t++) {
+                int y = static_cast<int>(t / tiles_x) * tile, x = static_cast<int>(t % tiles_x) * tile;
+                cv::Range rows(y, std::min(image.rows, y + tile)), cols(x, std::min(image.cols, x + tile));
+                std::vector<std::uint64_t>& sums = partial[omp_get_thread_num()];
+
+                for (long pair = 0; pair < pairs; pair++) {
+                    sums[pair] += static_cast<std::uint64_t>(calc_concentration_degree<G>(
+                            image, impl, DIFFERENCE, max_gray, (*offsets)[pair], rows, cols));
+                }
+            }
+
+            // Converted to double only once the partial sums of all threads are added up
+            for (long pair = 0; pair < pairs; pair++) {
+                std::uint64_t sum = 0;
+                for (const std::vector<std::uint64_t>& sums : partial) sum += sums[pair];
+
+                values[pair] = static_cast<double>(sum);
             }
 
-            angle_distribution[theta] = value;
+            return;
+        }
+
+        long items = pairs * bands;
+        std::vector<double> band_values(items, 0.0);
+
+        #pragma omp parallel for schedule(dynamic)
+        for (long item = 0; item < items; item++) {
+            const Offset& offset = (*offsets)[item / bands];
+            int band = item % bands;
+
+            cv::Range rows(band * band_height, std::min(image.rows, (band + 1) * band_height));
+
+            band_values[item] = calc_concentration_degree<G>(image, impl, options.engine, max_gray, offset, rows);
+        }
+
+        // Exact sum of the bands => same result as the whole image, independent of the number of threads
+        for (long pair = 0; pair < pairs; pair++) {
+            auto first = band_values.begin() + pair * bands;
+            values[pair] = exact_sum(first, first + bands);
         }
     }
 
 
+    /// Tag type handing over a storage type of the GLCM to generic lambdas (see GLCM::with_storage)
+    template <typename G>
+    struct Storage {
+        typedef G type;
+    };
+
+
     /**
-     *  Calculates the distribution for every angle R1 ... R2 (in degrees)
+     *  Calls the given function with the storage of the GLCM fitting the image and options
      *
+     *  @tparam T                       single channel type: char/uchar, short/ushort, int
+     *  @tparam F                       generic function taking a GLCM::Storage<G>
+     *  @param image                    the given image
+     *  @param options                  additional settings (e.g. which engine calculates Z)
+     *  @param max_gray                 number of gray levels of the image (size of the GLCM)
+     *  @param function                 the function called
+     */
+    template <typename T, typename F>
+    void with_storage(const cv::Mat_<T>& image, const Options& options, int max_gray, F function) {
+        // Every count is at most the number of pixels => smallest integer type holding it (halves the memory traffic)
+        // Too many gray levels for a dense GLCM => only the occupied cells get stored
+        bool sparse = options.engine == MATRIX && max_gray > MAX_DENSE_GRAY_LEVELS;
+
+        if (image.total() <= std::numeric_limits<ushort>::max()) {
+            if (sparse) {
+                function(Storage<SparseGLCM<ushort>>());
+            } else {
+                function(Storage<cv::Mat_<ushort>>());
+            }
+        } else if (image.total() <= static_cast<size_t>(std::numeric_limits<int>::max())) {
+            if (sparse) {
+                function(Storage<SparseGLCM<int>>());
+            } else {
+                function(Storage<cv::Mat_<int>>());
+            }
+        } else {
+            if (sparse) {
+                function(Storage<SparseGLCM<double>>());
+            } else {
+                function(Storage<cv::Mat_<double>>());
+            }
+        }
+    }
+
+
+    /**
+     *  Calculates the degree of concentration of every (angle, radius) pair
+     *
+     *  @tparam T                       single channel type: char/uchar, short/ushort, int
      *  @param image                    the given image
+     *  @param values                   the returned values (angles.size() x radii.size(), one row per angle)
      *  @param impl                     which implementation of the GLCM shall be used
+     *  @param radii                    the radii, a GLCM shall be calculated for
+     *  @param angles                   the angles, a GLCM shall be calculated for (in degrees!)
+     *  @param options                  additional settings (e.g. which engine calculates Z)
+     *  @param max_gray                 number of gray levels of the image (size of the GLCM)
+     *
+     *  @see    GLCM::calc_values_impl
+     */
+    template <typename T>
+    void calc_values(const cv::Mat_<T>& image, std::vector<double>& values, Implementation impl,
+                      const std::vector<unsigned int>& radii, const std::vector<unsigned int>& angles,
+                      const Options& options, int max_gray) {
+        with_storage(image, options, max_gray, [&](auto storage) {
+            typedef typename decltype(storage)::type G;
+            calc_values_impl<G>(image, values, impl, radii, angles, options, max_gray);
+        });
+    }
+
+
+    /**
+     *  Calculates values for all the given angles of Z(cv::Mat1d&) (equals the Z'-function from the paper)
+     *
+     *  The values of the radii get added up radius by radius (in the order of the schedule). Using an adaptive
+     *  schedule (Options::stable_radii) the radii get calculated in chunks, no further chunk gets calculated once the
+     *  angle with the lowest value did not change for the given number of radii.
+     *
+     *  @tparam T                       single channel type: char/uchar, short/ushort, int
+     *  @param image                    the given image
+     *  @param angle_distribution       the returned values of all the given angles (angles.size() of them)
+     *  @param impl                     which implementation of the GLCM shall be used
+     *  @param radii                    the radii, which shall be considered (see GLCM::radius_schedule)
+     *  @param angles                   the angles, a GLCM shall be calculated for (in degrees!)
+     *  @param options                  additional settings (e.g. which engine calculates Z)
+     *  @param max_gray                 number of gray levels of the image (size of the GLCM)
+     *  @return                         the number of radii actually added up
+     */
+    template <typename T>
+    unsigned int calc_angle_dist(const cv::Mat_<T>& image, double* angle_distribution, Implementation impl,
+                                  const std::vector<unsigned int>& radii, const std::vector<unsigned int>& angles,
+                                  const Options& options, int max_gray) {
+        if (options.engine == AUTOCORRELATION && impl != STANDARD) {
+            // Works on the whole distribution at once, only the standard GLCM is a linear function of the image
+            throw std::invalid_argument("[GLCM::calc_angle_dist] AUTOCORRELATION only supports STANDARD implementation!");
+        }
+
+        // The autocorrelation is exact for 8 bit gray values only, deeper images get calculated by DIFFERENCE instead
+        bool autocorrelation = options.engine == AUTOCORRELATION && max_gray <= Autocorrelation::MAX_GRAY_LEVELS;
+        Options difference = options;
+        difference.engine = DIFFERENCE;
+
+        size_t n_angles = angles.size();
+        std::fill(angle_distribution, angle_distribution + n_angles, 0.0);
+
+        // Summed up exactly (see GLCM::exact_sum), the distribution gets updated after every radius
+        std::vector<std::uint64_t> sums(n_angles, 0);
+
+        // AUTOCORRELATION gets every radius for (almost) free once the autocorrelation exists => always one chunk
+        size_t chunk = radii.size();
+        if (options.stable_radii != 0 && !autocorrelation) chunk = options.stable_radii;
+
+        size_t added = 0;
+        unsigned int stable = 0;
+        long lowest = -1;
+
+        for (size_t first = 0; first < radii.size(); first += chunk) {
+            std::vector<unsigned int> chunk_radii(radii.begin() + first, radii.begin() + std::min(first + chunk, radii.size()));
+            std::vector<double> values;
+
+            if (autocorrelation) {
+                Autocorrelation::calc_values(image, values, chunk_radii, angles);
+            } else {
+                calc_values(image, values, impl, chunk_radii, angles,
+                            options.engine == AUTOCORRELATION ? difference : options, max_gray);
+            }
+
+            for (size_t r = 0; r < chunk_radii.size(); r++) {
+                for (size_t theta = 0; theta < n_angles; theta++) {
+                    sums[theta] += static_cast<std::uint64_t>(values[theta * chunk_radii.size() + r]);
+                    angle_distribution[theta] = static_cast<double>(sums[theta]);
+                }
+
+                added++;
+                if (options.stable_radii == 0 || n_angles == 0) continue;
+
+                long current = std::distance(angle_distribution,
+                                             std::min_element(angle_distribution, angle_distribution + n_angles));
+                stable = current == lowest ? stable + 1 : 0;
+                lowest = current;
+
+                if (stable >= options.stable_radii) return static_cast<unsigned int>(added);
+            }
+        }
+
+        return static_cast<unsigned int>(added);
+    }
+
+
+    /// Fixed maximum radius or, if not stated, one based on the image boundaries
+    inline unsigned int max_radius_of(const cv::Size& size, unsigned int max_r) {
+        return max_r != 0 ? max_r : ceil(sqrt(2)*std::max(size.width/2, size.height/2));
+    }
+
+
+    /**
+     *  Returns the radii used for the given maximum radius according to the schedule of the options
+     *
      *  @param max_radius               the given maximum radius
-     *  @param range                    the range, which angles shall be considered
-     *  @return                         the filled vector of values  (size: range.second - range.first + 1)
+     *  @param options                  additional settings (which schedule is used)
+     *  @return                         the radii (ascending, explicit radii in the given order)
+     */
+    inline std::vector<unsigned int> radius_schedule(unsigned int max_radius, const Options& options) {
+        std::vector<unsigned int> radii;
+
+        switch (options.schedule) {
+            case EVERY_RADIUS:
+                for (unsigned int r = 1; r <= max_radius; r++) radii.push_back(r);
+                break;
+            case STRIDE:
+                if (options.stride == 0) {
+                    throw std::invalid_argument("[GLCM::radius_schedule] Stride has to be positive!");
+                }
+
+                for (unsigned int r = 1; r <= max_radius; r += options.stride) radii.push_back(r);
+                break;
+            case GEOMETRIC:
+                if (!(options.factor > 1.0)) {
+                    throw std::invalid_argument("[GLCM::radius_schedule] Factor has to be greater than 1!");
+                }
+
+                for (double r = 1; r <= max_radius; r = std::max(r + 1, std::round(r * options.factor))) {
+                    radii.push_back(static_cast<unsigned int>(r));
+                }
+                break;
+            case EXPLICIT:
+                for (unsigned int r : options.radii) {
+                    if (r == 0) throw std::invalid_argument("[GLCM::radius_schedule] Radii have to be positive!");
+                }
+
+                radii = options.radii;
+                break;
+        }
+
+        return radii;
+    }
+
+
+    /**
+     *  Prepares the image for the calculation: quantized to the given levels or, otherwise, every image deeper than
+     *  8 bit gets compacted to the range of gray values actually occupied if the GLCM gets created (MATRIX engine,
+     *  the GLCM shrinks to that range) or its gray values may be negative (signed / 32 bit images)
+     *
+     *  @param image                    the given image
+     *  @param options                  additional settings (number of levels, engine)
+     *  @param max_gray                 the returned number of gray levels (size of the GLCM, highest gray value + 1
+     *                                  for images used as they are)
+     *  @return                         the prepared image (shares the data of the given one if unchanged)
+     *
+     *  NOBUG:  Scheme 2 truncates every weighted gray value => the compacted image may differ slightly from the
+     *          given one (see GLCM::Util::compact), the other engines work on the unsigned gray values themselves
+     *  NOBUG:  Throws if the range of gray values is too wide for exact sums (see GLCM::Util::check_exact_range)
      */
-    std::vector<double> getAngleDistribution(const cv::Mat& image, Implementation impl, unsigned int max_radius,
-                                              const Range& range) {
-        std::vector<double> orientation_distribution(range.second - range.first + 1);
-        auto begin = static_cast<unsigned int>(range.first);
+    inline cv::Mat prepare_image(const cv::Mat& image, const Options& options, int& max_gray) {
+        if (options.levels != 0) {
+            Util::check_exact_range(options.levels - 1.0, image.total());
+            max_gray = static_cast<int>(options.levels);
+            return Util::quantize(image, options.levels);
+        }
+
+        int depth = image.type() & CV_MAT_DEPTH_MASK;
+
+        if (depth == CV_8U) {
+            max_gray = Util::max_gray_value(image);
+            return image;
+        }
+
+        if (options.engine == MATRIX || depth != CV_16U) return Util::compact(image, max_gray);
 
+        double min = 0, max = 0;
+        if (!image.empty()) cv::minMaxLoc(image, &min, &max);
+
+        Util::check_exact_range(max - min, image.total());
+        max_gray = static_cast<int>(max) + 1;
+        return image;
+    }
+
+
+    /**
+     *  Calls the given function with the image converted to its single channel type
+     *
+     *  @tparam F                       generic function taking a const cv::Mat_<T>&
+     *  @param image                    the given (prepared) image
+     *  @param function                 the function called
+     */
+    template <typename F>
+    void with_image_type(const cv::Mat& image, F function) {
         switch (image.type() & CV_MAT_DEPTH_MASK) {
             case CV_8SC1:
-                calc_angle_dist((cv::Mat_<char>&) image, orientation_distribution, impl, max_radius, begin);
+                function((const cv::Mat_<char>&) image);
                 break;
             case CV_8UC1:
-                calc_angle_dist((cv::Mat_<uchar>&) image, orientation_distribution, impl, max_radius, begin);
+                function((const cv::Mat_<uchar>&) image);
                 break;
             case CV_16SC1:
-                calc_angle_dist((cv::Mat_<short>&) image, orientation_distribution, impl, max_radius, begin);
+                function((const cv::Mat_<short>&) image);
                 break;
             case CV_16UC1:
-                calc_angle_dist((cv::Mat_<ushort>&) image, orientation_distribution, impl, max_radius, begin);
+                function((const cv::Mat_<ushort>&) image);
                 break;
             case CV_32SC1:
-                calc_angle_dist((cv::Mat_<int>&) image, orientation_distribution, impl, max_radius, begin);
+                function((const cv::Mat_<int>&) image);
                 break;
             default:
-                throw std::logic_error("[GLCM::getAngleDistribution_] Unsupported Mat-type!");
+                throw std::logic_error("[GLCM::with_image_type] Unsupported Mat-type!");
+        }
+    }
+
+
+    /**
+     *  Calculates the distribution for the given angles only (in degrees), written into the given buffer
+     *
+     *  @param image                    the given image
+     *  @param impl                     which implementation of the GLCM shall be used
+     *  @param max_radius               the given maximum radius (upper bound of the radius schedule)
+     *  @param angles                   the angles, which shall be considered (any order)
+     *  @param options                  additional settings (e.g. which engine calculates Z)
+     *  @param orientation_distribution the returned values (angles.size() of them, same order)
+     *  @param max_gray                 number of gray levels of an image already prepared (see GLCM::prepare_image),
+     *                                  0 => the image gets prepared by this call
+     */
+    inline void getAngleDistribution(const cv::Mat& image, Implementation impl, unsigned int max_radius,
+                                     const std::vector<unsigned int>& angles, const Options& options,
+                                     double* orientation_distribution, int max_gray = 0) {
+        std::vector<unsigned int> radii = radius_schedule(max_radius, options);
+        unsigned int added = 0;
+
+        // Quantized / compacted once per call => the GLCM (and everything working on it) shrinks
+        cv::Mat gray = max_gray != 0 ? image : prepare_image(image, options, max_gray);
+
+        with_image_type(gray, [&](const auto& typed) {
+            added = calc_angle_dist(typed, orientation_distribution, impl, radii, angles, options, max_gray);
+        });
+
+        if (options.statistics != nullptr) {
+            options.statistics->angles += angles.size();
+            options.statistics->radii += added;
         }
 
 #if AIOLOS_DEBUG_ANGLE_DISTRIBUTION
-        for (unsigned int i = 0; i < orientation_distribution.size(); i++) {
-        std::cout << "Winkel " << range.first + i << "°: " << orientation_distribution[i] << std::endl;
+        for (unsigned int i = 0; i < angles.size(); i++) {
+        std::cout << "Winkel " << angles[i] << "°: " << orientation_distribution[i] << std::endl;
     }
 #endif
+    }
+
 
+    /**
+     *  Calculates the distribution for the given angles only (in degrees)
+     *
+     *  @param image                    the given image
+     *  @param impl                     which implementation of the GLCM shall be used
+     *  @param max_radius               the given maximum radius (upper bound of the radius schedule)
+     *  @param angles                   the angles, which shall be considered (any order)
+     *  @param options                  additional settings (e.g. which engine calculates Z)
+     *  @param max_gray                 number of gray levels of an image already prepared (see GLCM::prepare_image),
+     *                                  0 => the image gets prepared by this call
+     *  @return                         the filled vector of values  (size: angles.size(), same order)
+     */
+    inline std::vector<double> getAngleDistribution(const cv::Mat& image, Implementation impl, unsigned int max_radius,
+                                                     const std::vector<unsigned int>& angles, const Options& options,
+                                                     int max_gray = 0) {
+        std::vector<double> orientation_distribution(angles.size());
+        getAngleDistribution(image, impl, max_radius, angles, options, orientation_distribution.data(), max_gray);
         return orientation_distribution;
     }
+
+
+    /**
+     *  Calculates the distribution for every angle R1 ... R2 (in degrees)
+     *
+     *  @param image                    the given image
+     *  @param impl                     which implementation of the GLCM shall be used
+     *  @param max_radius               the given maximum radius
+     *  @param range                    the range, which angles shall be considered
+     *  @param options                  additional settings (e.g. which engine calculates Z)
+     *  @param max_gray                 number of gray levels of an image already prepared, 0 => not prepared yet
+     *  @return                         the filled vector of values  (size: range.second - range.first + 1)
+     */
+    inline std::vector<double> getAngleDistribution(const cv::Mat& image, Implementation impl, unsigned int max_radius,
+                                                     const Range& range, const Options& options, int max_gray = 0) {
+        std::vector<unsigned int> angles(range.second - range.first + 1);
+        std::iota(angles.begin(), angles.end(), static_cast<unsigned int>(range.first));
+
+        return getAngleDistribution(image, impl, max_radius, angles, options, max_gray);
+    }
 }
 
 
@@ -0,0 +1,218 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#pragma once
+#ifndef AIOLOS_FEATURES_H
+#define AIOLOS_FEATURES_H
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <omp.h>
+#include <opencv2/opencv.hpp>
+
+#include "Distribution.h"
+#include "Privatized.h"
+
+
+namespace GLCM {
+    namespace Features {
+        /**
+         *  Sums of a single walk over the occupied cells of a GLCM, everything based on the raw counts => normalized
+         *  only once at the end (the total number of pairs is not known before)
+         */
+        class Accumulator {
+        public:
+            /// @param features     the requested features (GLCM::TextureFeature flags)
+            explicit Accumulator(int features) : features(features) {}
+
+
+            /// Adds a single (occupied) cell
+            void add(std::int64_t i, std::int64_t j, double count) {
+                std::uint64_t d = static_cast<std::uint64_t>(std::llabs(i - j));
+
+                n += count;
+                z += d * d * static_cast<std::uint64_t>(count);
+
+                if (features & ENERGY) energy += count * count;
+                if (features & ENTROPY) entropy += count * std::log(count);
+                if (features & HOMOGENEITY) homogeneity += count / static_cast<double>(1 + d * d);
+
+                if (features & CORRELATION) {
+                    sum_i += count * i;
+                    sum_j += count * j;
+                    sum_ii += count * i * i;
+                    sum_jj += count * j * j;
+                    sum_ij += count * i * j;
+                }
+            }
+
+
+            /// Degree of concentration of the GLCM (exact, equals GLCM::concentration_degree)
+            double concentration_degree() const { return static_cast<double>(z); }
+
+
+            /// Normalized features (all 0 for an empty GLCM, e.g. radius beyond the image)
+            TextureFeatures result() const {
+                TextureFeatures result;
+                if (n == 0) return result;
+
+                if (features & CONTRAST) result.contrast = static_cast<double>(z) / n;
+                if (features & ENERGY) result.energy = energy / (n * n);
+
+                // -Σ c/n ln(c/n) = ln n - Σ c ln c / n
+                if (features & ENTROPY) result.entropy = std::log(n) - entropy / n;
+                if (features & HOMOGENEITY) result.homogeneity = homogeneity / n;
+
+                if (features & CORRELATION) {
+                    double mean_i = sum_i / n, mean_j = sum_j / n;
+                    double var_i = sum_ii / n - mean_i * mean_i, var_j = sum_jj / n - mean_j * mean_j;
+
+                    // Constant image (or partners) => perfectly correlated by convention
+                    result.correlation = var_i > 0 && var_j > 0
+                                         ? (sum_ij / n - mean_i * mean_j) / std::sqrt(var_i * var_j) : 1.0;
+                }
+
+                return result;
+            }
+
+        private:
+            int features;
+
+            double n = 0;
+            std::uint64_t z = 0;
+            double energy = 0, entropy = 0, homogeneity = 0;
+            double sum_i = 0, sum_j = 0, sum_ii = 0, sum_jj = 0, sum_ij = 0;
+        };
+
+
+        /**
+         *  Walks the rows of a dense GLCM of the arena once, only the rows written get visited
+         *
+         *  @tparam C           count type of the GLCM: ushort, int (double only for huge images)
+         *  @param glcm         the GLCM, to work on
+         *  @param sums         the accumulator every occupied cell gets added to
+         */
+        template <typename C>
+        void accumulate(const TrackedGLCM<C>& glcm, Accumulator& sums) {
+            for (int y = 0; y < glcm.rows; y++) {
+                if (!glcm.touched_row(y)) continue;
+                const C* row = glcm[y];
+
+                for (int x = 0; x < glcm.cols; x++) {
+                    if (row[x] != 0) sums.add(y, x, static_cast<double>(row[x]));
+                }
+            }
+        }
+
+
+        /// Walks every row of a dense GLCM once (merged GLCM, see GLCM::Privatized::GLCM)
+        template <typename C>
+        void accumulate(const cv::Mat_<C>& glcm, Accumulator& sums) {
+            for (int y = 0; y < glcm.rows; y++) {
+                const C* row = glcm[y];
+
+                for (int x = 0; x < glcm.cols; x++) {
+                    if (row[x] != 0) sums.add(y, x, static_cast<double>(row[x]));
+                }
+            }
+        }
+
+
+        /// Walks the occupied cells of a sparse GLCM once
+        template <typename C>
+        void accumulate(const SparseGLCM<C>& glcm, Accumulator& sums) {
+            for (const auto& cell : glcm.cells()) {
+                if (cell.second == 0) continue;
+
+                sums.add(static_cast<std::int64_t>(cell.first / glcm.cols),
+                         static_cast<std::int64_t>(cell.first % glcm.cols), static_cast<double>(cell.second));
+            }
+        }
+
+
+        /**
+         *  Calculates the features and the degree of concentration of every (angle, radius) pair, every GLCM gets
+         *  created and walked only once (see GLCM::calc_values_impl for the distribution of the work items)
+         *
+         *  @tparam G           storage of the GLCM: cv::Mat_<C> or SparseGLCM<C>
+         *  @tparam T           single channel type: char/uchar, short/ushort, int
+         *  @param image        the given (prepared) image
+         *  @param impl         which implementation of the GLCM shall be used
+         *  @param radii        the radii, a GLCM shall be calculated for
+         *  @param angles       the angles, a GLCM shall be calculated for (in degrees!)
+         *  @param features     the requested features (GLCM::TextureFeature flags)
+         *  @param max_gray     number of gray levels of the image (size of the GLCM)
+         *  @param values       the returned features (angles.size() x radii.size(), one row per angle)
+         *  @param z            the returned degrees of concentration (same layout)
+         */
+        template <typename G, typename T>
+        void calc_features(const cv::Mat_<T>& image, Implementation impl, const std::vector<unsigned int>& radii,
+                           const std::vector<unsigned int>& angles, int features, int max_gray,
+                           std::vector<TextureFeatures>& values, std::vector<double>& z) {
+            long n_radii = static_cast<long>(radii.size());
+            long pairs = static_cast<long>(angles.size()) * n_radii;
+
+            values.assign(pairs, TextureFeatures());
+            z.assign(pairs, 0.0);
+
+            auto walk = [&](const auto& glcm, long pair) {
+                Accumulator sums(features);
+                accumulate(glcm, sums);
+
+                values[pair] = sums.result();
+                z[pair] = sums.concentration_degree();
+            };
+
+            if (impl == SCHEME1) {
+                // Every angle rotates the image once, all its radii work on that rotation
+                #pragma omp parallel
+                {
+                    Scheme1::Rotation<T> rotation;
+
+                    #pragma omp for schedule(dynamic)
+                    for (long theta = 0; theta < static_cast<long>(angles.size()); theta++) {
+                        Scheme1::rotate(image, angles[theta] * CV_PI / 180, rotation);
+
+                        for (long i = 0; i < n_radii; i++) {
+                            auto& glcm = arena_glcm<G>(max_gray);
+                            Scheme1::GLCM(rotation, glcm, static_cast<int>(radii[i]));
+                            walk(glcm, theta * n_radii + i);
+                        }
+                    }
+                }
+
+                return;
+            }
+
+            std::shared_ptr<const OffsetTable> offsets = offset_table(angles, radii);
+
+            if (pairs < omp_get_max_threads()) {
+                // Too few pairs to keep every thread busy: the statistics are not linear in the pairs (unlike Z) =>
+                // every GLCM gets created by all threads and merged (see GLCM::Privatized::GLCM)
+                for (long pair = 0; pair < pairs; pair++) {
+                    G glcm(max_gray, max_gray, typename G::value_type(0));
+                    Privatized::GLCM(glcm, image.rows, [&](G& partial, const cv::Range& rows) {
+                        create_glcm(image, impl, partial, (*offsets)[pair], rows);
+                    });
+
+                    walk(glcm, pair);
+                }
+
+                return;
+            }
+
+            #pragma omp parallel for schedule(dynamic)
+            for (long pair = 0; pair < pairs; pair++) {
+                auto& glcm = arena_glcm<G>(max_gray);
+                create_glcm(image, impl, glcm, (*offsets)[pair], cv::Range::all());
+                walk(glcm, pair);
+            }
+        }
+    }
+}
+
+
+#endif //AIOLOS_FEATURES_H
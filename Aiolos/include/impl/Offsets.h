@@ -0,0 +1,132 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#pragma once
+#ifndef AIOLOS_OFFSETS_H
+#define AIOLOS_OFFSETS_H
+
+#include <map>
+#include <mutex>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+
+namespace GLCM {
+    /// Largest number of offset tables kept in the cache (the least recently used one gets dropped once exceeded)
+    constexpr size_t MAX_CACHED_OFFSET_TABLES = 16;
+
+
+    /// Everything the GLCM implementations need to know about a single (angle, radius) pair
+    struct Offset {
+        double r, theta;                // the radius and the angle (in radiant!)
+        int dist_x, dist_y;             // offset to the partner (Scheme 2: to the upper left nearby point)
+        double c_1, c_2, c_3, c_4;      // interpolation weights of the four nearby points (Scheme 2)
+    };
+
+
+    /**
+     *  Calculates the offset and interpolation weights of a given radius and angle
+     *
+     *  @param r            the radius, the GLCM is based on
+     *  @param theta        the angle, the GLCM is based on (in radiant!)
+     *  @return             the offset and weights
+     *
+     *  NOBUG: dist_x / dist_y have to be signed, otherwise every angle > 90° results in broken weights!
+     */
+    inline Offset make_offset(double r, double theta) {
+        Offset o{};
+        o.r = r;
+        o.theta = theta;
+        o.dist_x = cvFloor(r*cos(theta));
+        o.dist_y = cvFloor(r*sin(theta));
+
+#if AIOLOS_TEST_SCHEME2_GLCM
+        // Using this "version": a, b, c, d should only be calculated once
+        {
+            double a = (o.dist_x+1 - r*cos(theta));
+            double b = (r*cos(theta) - o.dist_x);
+            double c = (o.dist_y+1 -r*sin(theta));
+            double d = (r*sin(theta) - o.dist_y);
+
+            o.c_1 = a*c;
+            o.c_2 = b*c;
+            o.c_3 = a*d;
+            o.c_4 = b*d;
+        }
+#else
+        // Using this "version": c_1-4 are calculated (possible extra calculations)
+        o.c_1 = (o.dist_x+1 - r*cos(theta)) * (o.dist_y+1 -r*sin(theta));
+        o.c_2 = (r*cos(theta) - o.dist_x) * (o.dist_y+1 - r*sin(theta));
+        o.c_3 = (o.dist_x+1 - r*cos(theta)) * (r*sin(theta) - o.dist_y);
+        o.c_4 = (r*cos(theta) - o.dist_x) * (r*sin(theta) - o.dist_y);
+#endif
+
+        return o;
+    }
+
+
+    /// Offsets of every (angle, radius) pair, one row per angle: table[angle * radii.size() + radius]
+    typedef std::vector<Offset> OffsetTable;
+
+
+    /**
+     *  Returns the offsets of every (angle, radius) pair. Every table gets built once and is cached for the following
+     *  calls using the same angles and radii (e.g. every frame of a video), no trigonometry is left per work item.
+     *
+     *  @param angles       the angles (in degrees!)
+     *  @param radii        the radii
+     *  @return             the table (one row per angle)
+     *
+     *  REVIEW: Tables are never modified after being built => shared read-only by all threads and calls
+     *  REVIEW: A full cache drops the least recently used table only (e.g. alternating settings keep their tables)
+     *  REVIEW: Built using sin/cos at runtime (not constexpr before C++26), exactly the values used before
+     */
+    inline std::shared_ptr<const OffsetTable> offset_table(const std::vector<unsigned int>& angles,
+                                                           const std::vector<unsigned int>& radii) {
+        typedef std::pair<std::vector<unsigned int>, std::vector<unsigned int>> Key;
+
+        /// Cached table + when it was used the last time
+        struct Entry {
+            std::shared_ptr<const OffsetTable> table;
+            unsigned long used;
+        };
+
+        static std::mutex mutex;
+        static std::map<Key, Entry> cache;
+        static unsigned long calls = 0;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        calls++;
+
+        Key key(angles, radii);
+        auto cached = cache.find(key);
+        if (cached != cache.end()) {
+            cached->second.used = calls;
+            return cached->second.table;
+        }
+
+        auto table = std::make_shared<OffsetTable>();
+        table->reserve(angles.size() * radii.size());
+
+        for (unsigned int angle : angles) {
+            for (unsigned int r : radii) table->push_back(make_offset(r, angle * CV_PI / 180));
+        }
+
+        if (cache.size() >= MAX_CACHED_OFFSET_TABLES) {
+            // Only a handful of tables => linear search for the least recently used one
+            cache.erase(std::min_element(cache.begin(), cache.end(), [](const auto& a, const auto& b) {
+                return a.second.used < b.second.used;
+            }));
+        }
+        cache.emplace(std::move(key), Entry{table, calls});
+
+        return table;
+    }
+}
+
+
+#endif //AIOLOS_OFFSETS_H
@@ -0,0 +1,76 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#pragma once
+#ifndef AIOLOS_PRIVATIZED_H
+#define AIOLOS_PRIVATIZED_H
+
+#include <vector>
+#include <algorithm>
+#include <omp.h>
+#include <opencv2/opencv.hpp>
+
+#include "Sparse.h"
+
+
+namespace GLCM {
+    namespace Privatized {
+        /// Adds every count of a private (dense) GLCM
+        template <typename C>
+        void merge(cv::Mat_<C>& glcm, const cv::Mat_<C>& other) {
+            cv::add(glcm, other, glcm);
+        }
+
+
+        /// Adds every count of a private (sparse) GLCM
+        template <typename C>
+        void merge(SparseGLCM<C>& glcm, const SparseGLCM<C>& other) {
+            glcm.add(other);
+        }
+
+
+        /**
+         *  Creates a single GLCM using all threads without any data race: every thread counts the pairs of its own
+         *  band of rows into a private GLCM, afterwards all of them get merged pairwise (tree reduction).
+         *
+         *  @tparam G           storage of the GLCM: cv::Mat_<C> or GLCM::SparseGLCM<C> (C: ushort, int, double)
+         *  @tparam Kernel      callable (G& glcm, const cv::Range& rows) creating the GLCM of a band of rows
+         *  @param glcm         the matrix, the GLCM is added to
+         *  @param rows         number of rows of the image
+         *  @param kernel       the kernel, e.g. GLCM::Standard::GLCM bound to image, radius and angle
+         *
+         *  REVIEW: Opens parallel regions itself => must not be called inside the work items of calc_angle_dist!
+         */
+        template <typename G, typename Kernel>
+        void GLCM(G& glcm, int rows, Kernel kernel) {
+            int tiles = std::max(1, std::min(omp_get_max_threads(), rows));
+            int tile_height = (rows + tiles - 1) / tiles;
+            using C = typename G::value_type;
+
+            // Constructed one by one, copies of a cv::Mat_ would share their data!
+            std::vector<G> partial;
+            partial.reserve(tiles);
+            for (int t = 0; t < tiles; t++) partial.emplace_back(glcm.rows, glcm.cols, C(0));
+
+            #pragma omp parallel for schedule(static)
+            for (int t = 0; t < tiles; t++) {
+                kernel(partial[t], cv::Range(t * tile_height, std::min(rows, (t + 1) * tile_height)));
+            }
+
+            // log2(tiles) rounds, every round merges disjoint pairs of private GLCMs in parallel
+            for (int step = 1; step < tiles; step *= 2) {
+                #pragma omp parallel for schedule(static)
+                for (int t = 0; t < tiles - step; t += 2 * step) {
+                    merge(partial[t], partial[t + step]);
+                }
+            }
+
+            merge(glcm, partial[0]);
+        }
+    }
+}
+
+
+#endif //AIOLOS_PRIVATIZED_H
@@ -0,0 +1,174 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#pragma once
+#ifndef AIOLOS_QUEUE_H
+#define AIOLOS_QUEUE_H
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <condition_variable>
+#include <cstddef>
+#include <algorithm>
+
+
+namespace GLCM {
+    /**
+     *  Bounded lock-free queue connecting exactly one producer thread with exactly one consumer thread (ring buffer)
+     *
+     *  @tparam T           type of the elements (moved in and out)
+     *
+     *  REVIEW: Only the producer writes the tail, only the consumer writes the head => acquire / release is enough
+     *  REVIEW: One slot always stays empty to tell a full from an empty queue
+     *  REVIEW: Waiting spins only briefly, blocks on a condition variable afterwards => a stage waiting for the
+     *          calculation does not take a core away from the OpenMP threads (see SPSCQueue::wait)
+     */
+    template <typename T>
+    class SPSCQueue {
+    public:
+        /**
+         *  @param capacity     number of elements the queue holds at most (at least 1)
+         */
+        explicit SPSCQueue(size_t capacity) : buffer(std::max<size_t>(capacity, 1) + 1) {}
+
+
+        /**
+         *  Adds an element, if the queue is not full (producer only)
+         *
+         *  @param value        the element (moved from if added)
+         *  @return             whether the element got added
+         */
+        bool try_push(T& value) {
+            size_t current = tail.load(std::memory_order_relaxed);
+            size_t next = (current + 1) % buffer.size();
+
+            if (next == head.load(std::memory_order_acquire)) return false;
+
+            buffer[current] = std::move(value);
+            tail.store(next, std::memory_order_release);
+
+            notify();
+            return true;
+        }
+
+
+        /**
+         *  Removes the oldest element, if the queue is not empty (consumer only)
+         *
+         *  @param value        the returned element
+         *  @return             whether an element got removed
+         */
+        bool try_pop(T& value) {
+            size_t current = head.load(std::memory_order_relaxed);
+
+            if (current == tail.load(std::memory_order_acquire)) return false;
+
+            value = std::move(buffer[current]);
+            head.store((current + 1) % buffer.size(), std::memory_order_release);
+
+            notify();
+            return true;
+        }
+
+
+        /// Whether the queue holds no element (exact for the consumer, a snapshot for everyone else)
+        bool empty() const {
+            return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+        }
+
+
+        /// Whether the queue holds as many elements as it can (exact for the producer, a snapshot for everyone else)
+        bool full() const {
+            return (tail.load(std::memory_order_acquire) + 1) % buffer.size() == head.load(std::memory_order_acquire);
+        }
+
+
+        /**
+         *  Waits until the predicate holds: spins briefly (the other side is usually about to push / pop), blocks on
+         *  a condition variable afterwards until woken up by SPSCQueue::notify
+         *
+         *  @tparam P           function returning whether to stop waiting
+         *  @param ready        the predicate (has to depend on the queue or on state followed by SPSCQueue::notify)
+         */
+        template <typename P>
+        void wait(P ready) {
+            for (int i = 0; i < SPINS; i++) {
+                if (ready()) return;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            sleeping.fetch_add(1);
+
+            // Pairs with the fence of notify => either the predicate sees the change or notify sees the sleeper
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            changed.wait(lock, ready);
+
+            sleeping.fetch_sub(1);
+        }
+
+
+        /// Wakes up every thread blocked in SPSCQueue::wait (to be called after changing the state of a predicate)
+        void notify() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (sleeping.load(std::memory_order_relaxed) == 0) return;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            changed.notify_all();
+        }
+
+
+        /**
+         *  Adds an element, waits while the queue is full (producer only)
+         *
+         *  @param value        the element
+         *  @param stop         waiting gets cancelled once set (followed by SPSCQueue::notify)
+         *  @return             whether the element got added (false only if cancelled)
+         */
+        bool push(T& value, const std::atomic<bool>& stop) {
+            while (!try_push(value)) {
+                if (stop.load(std::memory_order_relaxed)) return false;
+                wait([&]() { return !full() || stop.load(std::memory_order_relaxed); });
+            }
+
+            return true;
+        }
+
+
+        /**
+         *  Removes the oldest element, waits while the queue is empty (consumer only)
+         *
+         *  @param value        the returned element
+         *  @param stop         waiting gets cancelled once set (followed by SPSCQueue::notify)
+         *  @return             whether an element got removed (false only if cancelled)
+         */
+        bool pop(T& value, const std::atomic<bool>& stop) {
+            while (!try_pop(value)) {
+                if (stop.load(std::memory_order_relaxed)) return false;
+                wait([&]() { return !empty() || stop.load(std::memory_order_relaxed); });
+            }
+
+            return true;
+        }
+
+    private:
+        /// Number of checks of the predicate before blocking (about a microsecond)
+        static constexpr int SPINS = 256;
+
+        std::vector<T> buffer;
+
+        // Own cache lines => producer and consumer do not invalidate each other on every operation
+        alignas(64) std::atomic<size_t> head{0};
+        alignas(64) std::atomic<size_t> tail{0};
+
+        // Only used once a thread has to block
+        alignas(64) std::atomic<int> sleeping{0};
+        std::mutex mutex;
+        std::condition_variable changed;
+    };
+}
+
+
+#endif //AIOLOS_QUEUE_H
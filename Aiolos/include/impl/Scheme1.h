@@ -6,25 +6,194 @@
 #ifndef AIOLOS_SCHEME1_H
 #define AIOLOS_SCHEME1_H
 
+#include <cmath>
+#include <vector>
 #include <omp.h>
 #include <opencv2/opencv.hpp>
 
+#include "Offsets.h"
+#include "util/SimdFunctions.h"
+
 
 namespace GLCM {
     namespace Scheme1 {
+        /// Image rotated by an angle (its direction becomes horizontal) + which pixels are based on the original image
+        template <typename T>
+        struct Rotation {
+            cv::Mat_<T> image;              // the rotated image (square, fits every angle => buffer gets reused)
+            std::vector<cv::Range> spans;   // every row: columns interpolated from inside the original image only
+        };
+
+
+        /// Side of the rotated (square) image, fits every angle of an image of the given size
+        inline int rotated_side(const cv::Size& size) {
+            return static_cast<int>(std::ceil(std::sqrt(static_cast<double>(size.width) * size.width
+                                                        + static_cast<double>(size.height) * size.height))) + 1;
+        }
+
+
         /**
-         *  Adjusted version for creating a single GLCM used by Scheme 1
+         *  Rotates the image, so that the given angle becomes horizontal: every pair (p, p + r*(cos θ, sin θ)) of the
+         *  image becomes the pair (p', p' + (r, 0)) of the rotated image (bilinear interpolation)
          *
          *  @tparam T           single channel type: char/uchar, short/ushort, int
          *  @param image        the given image
+         *  @param theta        the angle (in radiant!)
+         *  @param rotation     the rotation, its buffers get reused
+         *
+         *  REVIEW: Spans are calculated from the mapping itself (slightly shrunk), no mask image needed!
+         */
+        template <typename T>
+        void rotate(const cv::Mat_<T>& image, double theta, Rotation<T>& rotation) {
+            int side = rotated_side(image.size());
+            double cos_t = std::cos(theta), sin_t = std::sin(theta);
+            double c_x = (image.cols - 1) / 2.0, c_y = (image.rows - 1) / 2.0, c = (side - 1) / 2.0;
+
+            // Maps every pixel of the rotated image to the original one: src = A * (dst - c) + center
+            cv::Mat1d map(2, 3);
+            map(0, 0) = cos_t;
+            map(0, 1) = -sin_t;
+            map(0, 2) = c_x - cos_t * c + sin_t * c;
+            map(1, 0) = sin_t;
+            map(1, 1) = cos_t;
+            map(1, 2) = c_y - sin_t * c - cos_t * c;
+
+            int depth = image.type() & CV_MAT_DEPTH_MASK;
+            if (depth == CV_8U || depth == CV_16U || depth == CV_16S) {
+                cv::warpAffine(image, rotation.image, map, cv::Size(side, side), cv::INTER_LINEAR | cv::WARP_INVERSE_MAP,
+                               cv::BORDER_CONSTANT, cv::Scalar(0));
+            } else {
+                // No interpolation of 8 bit signed / 32 bit images => using doubles instead
+                cv::Mat converted, rotated;
+                image.convertTo(converted, CV_64F);
+                cv::warpAffine(converted, rotated, map, cv::Size(side, side), cv::INTER_LINEAR | cv::WARP_INVERSE_MAP,
+                               cv::BORDER_CONSTANT, cv::Scalar(0));
+                rotated.convertTo(rotation.image, image.type());
+            }
+
+            // Every row: x with margin <= src_x <= cols-1 - margin and margin <= src_y <= rows-1 - margin
+            const double margin = 1.0 / 16;
+            rotation.spans.resize(side);
+
+            for (int y = 0; y < side; y++) {
+                double low = 0, high = side - 1;
+
+                auto restrict_to = [&](double slope, double base, double min, double max) {
+                    // min <= slope * x + base <= max
+                    if (std::abs(slope) < 1e-12) {
+                        if (base < min || base > max) high = -1;
+                        return;
+                    }
+
+                    double a = (min - base) / slope, b = (max - base) / slope;
+                    low = std::max(low, std::min(a, b));
+                    high = std::min(high, std::max(a, b));
+                };
+
+                restrict_to(cos_t, map(0, 1) * y + map(0, 2), margin, image.cols - 1 - margin);
+                restrict_to(sin_t, map(1, 1) * y + map(1, 2), margin, image.rows - 1 - margin);
+
+                int start = static_cast<int>(std::ceil(low)), end = static_cast<int>(std::floor(high)) + 1;
+                rotation.spans[y] = start < end ? cv::Range(start, end) : cv::Range(0, 0);
+            }
+        }
+
+
+        /**
+         *  Creates the GLCM of a rotated image, the partner of every pixel lies r pixels to its right
+         *
+         *  @tparam T           single channel type: char/uchar, short/ushort, int
+         *  @tparam G           storage of the GLCM: cv::Mat_<C> or GLCM::SparseGLCM<C> (C: ushort, int, double)
+         *  @param rotation     the rotated image
          *  @param glcm         the matrix, the GLCM is stored to
          *  @param r            the radius, the GLCM is based on
-         *  @param theta        the angle, the GLCM is based on (in radiant!)
+         *  @param rows         the band of rows (of the rotated image), whose pixels (and their partners) are considered
+         *
+         *  REVIEW: Runs inside the work items of GLCM::calc_angle_dist => no parallel region of its own!
+         */
+        template <typename T, typename G>
+        void GLCM(const Rotation<T>& rotation, G& glcm, int r, const cv::Range& rows = cv::Range::all()) {
+            for (int y = std::max(0, rows.start); y < std::min(rotation.image.rows, rows.end); y++) {
+                const T* row = rotation.image[y];
+
+                for (int x = rotation.spans[y].start; x < rotation.spans[y].end - r; x++) {
+                    glcm(row[x], row[x + r])++;
+                }
+            }
+        }
+
+
+        /**
+         *  Calculates the degree of concentration of a rotated image without creating the GLCM, every pair is part of
+         *  the same row => contiguous spans (see GLCM::Util::squared_differences)
+         *
+         *  @tparam T           single channel type: char/uchar, short/ushort, int
+         *  @param rotation     the rotated image
+         *  @param r            the radius, the GLCM is based on
+         *  @param rows         the band of rows (of the rotated image), whose pixels (and their partners) are considered
+         *  @param cols         the band of columns (of the rotated image), whose pixels are considered
+         *  @return             the degree of concentration
+         */
+        template <typename T>
+        double concentration_degree(const Rotation<T>& rotation, int r, const cv::Range& rows = cv::Range::all(),
+                                      const cv::Range& cols = cv::Range::all()) {
+            std::uint64_t value = 0;
+
+            for (int y = std::max(0, rows.start); y < std::min(rotation.image.rows, rows.end); y++) {
+                int x_begin = std::max(rotation.spans[y].start, cols.start);
+                int x_end = std::min(rotation.spans[y].end - r, cols.end);
+                if (x_begin >= x_end) continue;
+
+                const T* row = rotation.image[y];
+                value += Util::squared_differences(row + x_begin, row + x_begin + r, x_end - x_begin);
+            }
+
+            return static_cast<double>(value);
+        }
+
+
+        /**
+         *  Adjusted version for creating a single GLCM used by Scheme 1
          *
+         *  @tparam T           single channel type: char/uchar, short/ushort, int
+         *  @tparam G           storage of the GLCM: cv::Mat_<C> or GLCM::SparseGLCM<C> (C: ushort, int, double)
+         *  @param image        the given image
+         *  @param glcm         the matrix, the GLCM is stored to
+         *  @param offset       the offset (and weights) of the radius and angle, the GLCM is based on
+         *  @param rows         the band of rows (of the rotated image), whose pixels (and their partners) are considered
+         *
+         *  REVIEW: Rotates the image for every call, GLCM::calc_values_impl rotates once per angle instead!
+         */
+        template <typename T, typename G>
+        void GLCM(const cv::Mat_<T>& image, G& glcm, const Offset& offset,
+                    const cv::Range& rows = cv::Range::all()) {
+            Rotation<T> rotation;
+            rotate(image, offset.theta, rotation);
+
+            GLCM(rotation, glcm, static_cast<int>(offset.r), rows);
+        }
+
+
+        /**
+         *  Calculates the degree of concentration of the Scheme 1 GLCM without creating it
+         *
+         *  @tparam T           single channel type: char/uchar, short/ushort, int
+         *  @param image        the given image
+         *  @param offset       the offset (and weights) of the radius and angle, the GLCM is based on
+         *  @param rows         the band of rows (of the rotated image), whose pixels (and their partners) are considered
+         *  @param cols         the band of columns (of the rotated image), whose pixels are considered
+         *  @return             the degree of concentration
+         *
+         *  REVIEW: Rotates the image for every call, GLCM::calc_values_impl rotates once per angle instead!
          */
         template <typename T>
-        void GLCM(const cv::Mat_<T>& image, cv::Mat1d& glcm, double r, double theta) {
-            throw std::logic_error("[Scheme1::GLCM_] Not implemented yet!");
+        double concentration_degree(const cv::Mat_<T>& image, const Offset& offset,
+                                      const cv::Range& rows = cv::Range::all(),
+                                      const cv::Range& cols = cv::Range::all()) {
+            Rotation<T> rotation;
+            rotate(image, offset.theta, rotation);
+
+            return concentration_degree(rotation, static_cast<int>(offset.r), rows, cols);
         }
     }
 }
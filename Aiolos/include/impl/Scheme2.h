@@ -16,64 +16,37 @@ namespace GLCM {
          *  Adjusted version for creating a single GLCM used by Scheme 2
          *
          *  @tparam T           single channel type: char/uchar, short/ushort, int
+         *  @tparam G           storage of the GLCM: cv::Mat_<C> or GLCM::SparseGLCM<C> (C: ushort, int, double)
          *  @param image        the given image
          *  @param glcm         the matrix, the GLCM is stored to
-         *  @param r            the radius, the GLCM is based on
-         *  @param theta        the angle, the GLCM is based on (in radiant!)
-         *
-         *  TODO: change x, y to int (and x2, y2 as well) to test for negative values!
+         *  @param offset       the offset (and weights) of the radius and angle, the GLCM is based on
+         *  @param rows         the band of rows, whose pixels (and their partners) are considered
          */
-        template <typename T>
-        void GLCM(const cv::Mat_<T>& image, cv::Mat1d& glcm, double r, double theta) {
-            unsigned int dist_x = floor(r*cos(theta));
-            unsigned int dist_y = floor(r*sin(theta));
-
-#if AIOLOS_TEST_SCHEME2_GLCM
-            // Using this "version": a, b, c, d should only be calculated once
-            double c_1, c_2, c_3, c_4;
-            {
-                double a = (dist_x+1 - r*cos(theta));
-                double b = (r*cos(theta) - dist_x);
-                double c = (dist_y+1 -r*sin(theta));
-                double d = (r*sin(theta) - dist_y);
-
-                c_1 = a*c;
-                c_2 = b*c;
-                c_3 = a*d;
-                c_4 = b*d;
-            }
-#else
-            // Using this "version": c_1-4 are calculated (possible extra calculations)
-            double c_1 = (dist_x+1 - r*cos(theta)) * (dist_y+1 -r*sin(theta));
-            double c_2 = (r*cos(theta) - dist_x) * (dist_y+1 - r*sin(theta));
-            double c_3 = (dist_x+1 - r*cos(theta)) * (r*sin(theta) - dist_y);
-            double c_4 = (r*cos(theta) - dist_x) * (r*sin(theta) - dist_y);
-#endif
-
-            #pragma omp parallel for collapse(2) shared(dist_x, dist_y, c_1, c_2, c_3, c_4)
-            for (unsigned int y = 0; y < image.rows; y++) {
-                for (unsigned int x = 0; x < image.cols; x++) {
+        template <typename T, typename G>
+        void GLCM(const cv::Mat_<T>& image, G& glcm, const Offset& offset,
+                    const cv::Range& rows = cv::Range::all()) {
+            for (int y = std::max(0, rows.start); y < std::min(image.rows, rows.end); y++) {
+                for (int x = 0; x < image.cols; x++) {
                     // TODO: gibt es nicht einen besseren Weg als einfach der nächste Schleifendurchlauf?
-                    // TODO: ich weiss noch nicht genau wann und warum gray1-4 addiert grösser sein können als die Anzahl der Spalten!
 
-                    unsigned int y1 = y + dist_y;
+                    int y1 = y + offset.dist_y;
                     if (y1 < 0 || y1 >= image.rows) continue;
 
-                    unsigned int x1 = x + dist_x;
+                    int x1 = x + offset.dist_x;
                     if (x1 < 0 || x1 >= image.cols) continue;
 
-                    unsigned int y2 = y + dist_y + 1;
+                    int y2 = y + offset.dist_y + 1;
                     if (y2 < 0 || y2 >= image.rows) continue;
 
-                    unsigned int x2 = x + dist_x + 1;
+                    int x2 = x + offset.dist_x + 1;
                     if (x2 < 0 || x2 >= image.cols) continue;
 
-                    unsigned int gray_1 = c_1 * image(y1, x1);
-                    unsigned int gray_2 = c_2 * image(y1, x2);
-                    unsigned int gray_3 = c_3 * image(y2, x1);
-                    unsigned int gray_4 = c_4 * image(y2, x2);
+                    unsigned int gray_1 = offset.c_1 * image(y1, x1);
+                    unsigned int gray_2 = offset.c_2 * image(y1, x2);
+                    unsigned int gray_3 = offset.c_3 * image(y2, x1);
+                    unsigned int gray_4 = offset.c_4 * image(y2, x2);
 
-                    if (gray_1+gray_2+gray_3+gray_4 > glcm.cols) {
+                    if (gray_1+gray_2+gray_3+gray_4 >= glcm.cols) {
 
 #if AIOLOS_DEBUG_SCHEME2_GLCM
                         #pragma omp critical
@@ -90,6 +63,44 @@ namespace GLCM {
                 }
             }
         }
+
+
+        /**
+         *  Calculates the degree of concentration of the Scheme 2 GLCM without creating it, therefore the squared
+         *  difference of every gray value and its interpolated partner gets summed up directly
+         *
+         *  @tparam T           single channel type: char/uchar, short/ushort, int
+         *  @param image        the given image
+         *  @param offset       the offset (and weights) of the radius and angle, the GLCM is based on
+         *  @param rows         the band of rows, whose pixels (and their partners) are considered
+         *  @param cols         the band of columns, whose pixels (and their partners) are considered
+         *  @return             the degree of concentration
+         */
+        template <typename T>
+        double concentration_degree(const cv::Mat_<T>& image, const Offset& offset,
+                                      const cv::Range& rows = cv::Range::all(),
+                                      const cv::Range& cols = cv::Range::all()) {
+            // Only pixels whose four nearby points lie inside the image as well => no checks inside the loop needed
+            int y_begin = std::max({0, -offset.dist_y, rows.start});
+            int y_end = std::min({image.rows, image.rows - offset.dist_y - 1, rows.end});
+            int x_begin = std::max({0, -offset.dist_x, cols.start});
+            int x_end = std::min({image.cols, image.cols - offset.dist_x - 1, cols.end});
+
+            std::uint64_t value = 0;
+
+            if (x_begin >= x_end) return 0.0;
+
+            // Same (truncated) interpolation as used by GLCM::Scheme2::GLCM, vectorized for 8 and 16 bit
+            for (int y = y_begin; y < y_end; y++) {
+                value += Util::interpolated_squared_differences(image[y] + x_begin,
+                                                                image[y + offset.dist_y] + x_begin + offset.dist_x,
+                                                                image[y + offset.dist_y + 1] + x_begin + offset.dist_x,
+                                                                x_end - x_begin,
+                                                                offset.c_1, offset.c_2, offset.c_3, offset.c_4);
+            }
+
+            return static_cast<double>(value);
+        }
     }
 }
 
@@ -9,21 +9,117 @@
 #include <omp.h>
 #include <opencv2/opencv.hpp>
 
+#include "Offsets.h"
+#include "../util/SimdFunctions.h"
+
 
 namespace GLCM {
     namespace Scheme3 {
+        /**
+         *  Interpolates the partners of a row of pixels once, every partner gets summed up from its four nearby points
+         *  (weighted as in Scheme 2) and rounded afterwards, instead of truncating every weighted gray value on its own
+         *
+         *  @tparam T           single channel type: char/uchar, short/ushort, int
+         *  @param image        the given image
+         *  @param offset       the offset (and weights) of the radius and angle, the GLCM is based on
+         *  @param y            the row of pixels, whose partners get interpolated
+         *  @param cols         the (valid) columns of pixels, whose partners get interpolated
+         *  @param partners     the buffer the partners are stored to (reused, only grows)
+         *  @return             pointer to the first partner
+         */
+        template <typename T>
+        const T* interpolate(const cv::Mat_<T>& image, const Offset& offset, int y, const cv::Range& cols,
+                               std::vector<T>& partners) {
+            if (partners.size() < static_cast<std::size_t>(cols.size())) partners.resize(cols.size());
+
+            Util::interpolate(image[y + offset.dist_y] + cols.start + offset.dist_x,
+                              image[y + offset.dist_y + 1] + cols.start + offset.dist_x,
+                              cols.size(), offset.c_1, offset.c_2, offset.c_3, offset.c_4, partners.data());
+
+            return partners.data();
+        }
+
+
+        /**
+         *  Returns the rows and columns of pixels, whose four nearby points of the partner lie inside the image
+         *
+         *  @param image        the given image
+         *  @param offset       the offset of the radius and angle
+         *  @param rows         the band of rows, whose pixels are considered
+         *  @param cols         the band of columns, whose pixels are considered
+         *  @return             the valid rows and columns (may be empty or reversed)
+         */
+        inline std::pair<cv::Range, cv::Range> valid(const cv::Mat& image, const Offset& offset, const cv::Range& rows,
+                                                       const cv::Range& cols) {
+            cv::Range y(std::max({0, -offset.dist_y, rows.start}),
+                        std::min({image.rows, image.rows - offset.dist_y - 1, rows.end}));
+            cv::Range x(std::max({0, -offset.dist_x, cols.start}),
+                        std::min({image.cols, image.cols - offset.dist_x - 1, cols.end}));
+
+            return {y, x};
+        }
+
+
         /**
          *  Adjusted version for creating a single GLCM used by Scheme 3
          *
          *  @tparam T           single channel type: char/uchar, short/ushort, int
+         *  @tparam G           storage of the GLCM: cv::Mat_<C> or GLCM::SparseGLCM<C> (C: ushort, int, double)
          *  @param image        the given image
          *  @param glcm         the matrix, the GLCM is stored to
-         *  @param r            the radius, the GLCM is based on
-         *  @param theta        the angle, the GLCM is based on (in radiant!)
+         *  @param offset       the offset (and weights) of the radius and angle, the GLCM is based on
+         *  @param rows         the band of rows, whose pixels (and their partners) are considered
+         *
+         *  NOBUG: The interpolated partner is a convex combination of gray values => it never exceeds the GLCM!
+         */
+        template <typename T, typename G>
+        void GLCM(const cv::Mat_<T>& image, G& glcm, const Offset& offset,
+                    const cv::Range& rows = cv::Range::all()) {
+            static thread_local std::vector<T> partners;
+
+            auto range = valid(image, offset, rows, cv::Range::all());
+            if (range.first.size() <= 0 || range.second.size() <= 0) return;
+
+            for (int y = range.first.start; y < range.first.end; y++) {
+                const T* row = image[y] + range.second.start;
+                const T* partner = interpolate(image, offset, y, range.second, partners);
+
+                for (int x = 0; x < range.second.size(); x++) {
+                    glcm(row[x], partner[x])++;
+                }
+            }
+        }
+
+
+        /**
+         *  Calculates the degree of concentration of the Scheme 3 GLCM without creating it, therefore the squared
+         *  difference of every gray value and its interpolated partner gets summed up directly
+         *
+         *  @tparam T           single channel type: char/uchar, short/ushort, int
+         *  @param image        the given image
+         *  @param offset       the offset (and weights) of the radius and angle, the GLCM is based on
+         *  @param rows         the band of rows, whose pixels (and their partners) are considered
+         *  @param cols         the band of columns, whose pixels (and their partners) are considered
+         *  @return             the degree of concentration
          */
         template <typename T>
-        void GLCM(const cv::Mat_<T>& image, cv::Mat1d& glcm, double r, double theta) {
-            throw std::logic_error("[GLCM::Scheme3::GLCM] Not implemented yet!");
+        double concentration_degree(const cv::Mat_<T>& image, const Offset& offset,
+                                      const cv::Range& rows = cv::Range::all(),
+                                      const cv::Range& cols = cv::Range::all()) {
+            static thread_local std::vector<T> partners;
+
+            auto range = valid(image, offset, rows, cols);
+            if (range.first.size() <= 0 || range.second.size() <= 0) return 0.0;
+
+            std::uint64_t value = 0;
+
+            for (int y = range.first.start; y < range.first.end; y++) {
+                value += Util::squared_differences(image[y] + range.second.start,
+                                                   interpolate(image, offset, y, range.second, partners),
+                                                   range.second.size());
+            }
+
+            return static_cast<double>(value);
         }
     }
 }
@@ -0,0 +1,294 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#pragma once
+#ifndef AIOLOS_SEARCH_H
+#define AIOLOS_SEARCH_H
+
+#include <map>
+#include <set>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "Distribution.h"
+
+
+namespace GLCM {
+    /// Smallest edge length (in pixels) a level of the image pyramid may have (see GLCM::pyramid_search)
+    constexpr int MIN_PYRAMID_SIZE = 32;
+
+    /// Smallest maximum radius a level of the image pyramid may have (fewer radii => too few distinct offsets)
+    constexpr unsigned int MIN_PYRAMID_RADIUS = 4;
+
+
+    /**
+     *  Returns the best angles evaluated so far
+     *
+     *  @param values       value of every angle evaluated
+     *  @param n            number of angles to return (at most)
+     *  @return             the angles (lowest value first, ties => lowest angle)
+     */
+    inline std::vector<unsigned int> best_candidates(const std::map<unsigned int, double>& values, size_t n) {
+        std::vector<std::pair<double, unsigned int>> ranked;
+        for (const auto& value : values) ranked.emplace_back(value.second, value.first);
+
+        n = std::min(n, ranked.size());
+        std::partial_sort(ranked.begin(), ranked.begin() + n, ranked.end());
+
+        std::vector<unsigned int> candidates;
+        for (size_t i = 0; i < n; i++) candidates.push_back(ranked[i].second);
+
+        return candidates;
+    }
+
+
+    /**
+     *  Searches the dominant angle of a range coarse-to-fine instead of evaluating every angle: the range gets sampled
+     *  using the first step size (both boundaries included), afterwards every following step size refines around the
+     *  best candidates found so far (up to the previous step size away). Angles evaluated once are never evaluated again.
+     *
+     *  @param image        the given image
+     *  @param impl         which implementation of the GLCM shall be used
+     *  @param max_radius   the given maximum radius
+     *  @param range        interval of angles to consider!
+     *  @param options      additional settings (step sizes and number of candidates)
+     *  @param max_gray     number of gray levels of an image already prepared, 0 => not prepared yet
+     *  @return             the dominant angle (in degrees!)
+     *
+     *  REVIEW: Relies on a smooth distribution (true for real textures), a narrow minimum between two coarse samples
+     *          can be missed!
+     *  REVIEW: Same tie-breaking as the full search (lowest angle wins)
+     */
+    inline unsigned int coarse_to_fine_search(const cv::Mat& image, Implementation impl, unsigned int max_radius,
+                                               const Range& range, const Options& options, int max_gray = 0) {
+        std::vector<unsigned int> steps = options.steps;
+
+        if (steps.empty() || options.candidates == 0) {
+            throw std::invalid_argument("[GLCM::coarse_to_fine_search] At least one step size and one candidate needed!");
+        }
+
+        for (unsigned int i = 0; i < steps.size(); i++) {
+            if (steps[i] == 0 || (i > 0 && steps[i] >= steps[i-1])) {
+                throw std::invalid_argument("[GLCM::coarse_to_fine_search] Step sizes have to be positive and descending!");
+            }
+        }
+
+        // The last round always has to reach the resolution of the full search
+        if (steps.back() != 1) steps.push_back(1);
+
+        unsigned int first = range.first, last = range.second;
+        std::map<unsigned int, double> values;
+
+        // Values of all rounds get compared => the radii an adaptive schedule stopped at in the first round are fixed
+        Options round_options = options;
+        Statistics round_statistics;
+        round_options.statistics = &round_statistics;
+
+        // Prepared (quantized / compacted) once instead of once per round
+        cv::Mat gray = max_gray != 0 ? image : prepare_image(image, options, max_gray);
+
+        // All angles of a round get calculated at once (one parallel region)
+        auto evaluate = [&](const std::set<unsigned int>& angles) {
+            std::vector<unsigned int> missing;
+            for (unsigned int angle : angles) {
+                if (values.find(angle) == values.end()) missing.push_back(angle);
+            }
+
+            if (missing.empty()) return;
+
+            std::vector<double> dist = getAngleDistribution(gray, impl, max_radius, missing, round_options, max_gray);
+            for (unsigned int i = 0; i < missing.size(); i++) values[missing[i]] = dist[i];
+        };
+
+        std::set<unsigned int> coarse;
+        for (unsigned int angle = first; angle <= last; angle += steps[0]) coarse.insert(angle);
+        coarse.insert(last);
+        evaluate(coarse);
+
+        if (options.stable_radii != 0) {
+            std::vector<unsigned int> radii = radius_schedule(max_radius, options);
+            radii.resize(round_statistics.radii);
+
+            round_options.schedule = EXPLICIT;
+            round_options.radii = radii;
+            round_options.stable_radii = 0;
+        }
+
+        for (unsigned int round = 1; round < steps.size(); round++) {
+            std::set<unsigned int> fine;
+            for (unsigned int candidate : best_candidates(values, options.candidates)) {
+                for (unsigned int d = steps[round]; d < steps[round-1]; d += steps[round]) {
+                    if (candidate >= first + d) fine.insert(candidate - d);
+                    if (candidate + d <= last) fine.insert(candidate + d);
+                }
+            }
+
+            evaluate(fine);
+        }
+
+        if (options.statistics != nullptr) {
+            options.statistics->angles += round_statistics.angles;
+            options.statistics->radii += round_statistics.radii;
+        }
+
+        return std::min_element(values.begin(), values.end(),
+                                [](const std::pair<const unsigned int, double>& a,
+                                   const std::pair<const unsigned int, double>& b) {
+                                    return a.second < b.second;
+                                })->first;
+    }
+
+
+    /**
+     *  Halves the size of an image (next level of the image pyramid)
+     *
+     *  @param image        the given image (prepared)
+     *  @return             the smaller image (same type, gray values inside the range of the given ones)
+     */
+    inline cv::Mat downsample(const cv::Mat& image) {
+        cv::Mat smaller;
+
+        switch (image.depth()) {
+            case CV_8U:
+            case CV_16U:
+            case CV_16S:
+                cv::pyrDown(image, smaller);
+                return smaller;
+            default:
+                // pyrDown does not support 8S / 32S => filtered as double, rounded back afterwards
+                cv::Mat converted;
+                image.convertTo(converted, CV_64F);
+                cv::pyrDown(converted, converted);
+                converted.convertTo(smaller, image.type());
+                return smaller;
+        }
+    }
+
+
+    /**
+     *  Searches the dominant angle using an image pyramid: the whole range gets evaluated on the smallest level only
+     *  (with a maximum radius scaled down as well), every finer level evaluates the angles around the best candidates
+     *  of the previous level only (±options.refinement). Cost is about the one of the smallest level.
+     *
+     *  @param image        the given image
+     *  @param impl         which implementation of the GLCM shall be used
+     *  @param max_radius   the given maximum radius (of the full resolution)
+     *  @param range        interval of angles to consider!
+     *  @param options      additional settings (number of levels, refinement and number of candidates)
+     *  @param max_gray     number of gray levels of an image already prepared, 0 => not prepared yet
+     *  @return             the dominant angle (in degrees!)
+     *
+     *  REVIEW: Prepared once, every level gets decimated from the prepared image => same gray levels on every level
+     *  REVIEW: Levels stop at GLCM::MIN_PYRAMID_SIZE pixels / GLCM::MIN_PYRAMID_RADIUS, small images (or radii)
+     *          search the whole range at full resolution
+     *  REVIEW: Relies on the texture surviving the decimation, very fine textures vanish on coarse levels!
+     */
+    inline unsigned int pyramid_search(const cv::Mat& image, Implementation impl, unsigned int max_radius,
+                                        const Range& range, const Options& options, int max_gray = 0) {
+        if (options.candidates == 0) {
+            throw std::invalid_argument("[GLCM::pyramid_search] At least one candidate needed!");
+        }
+
+        cv::Mat gray = max_gray != 0 ? image : prepare_image(image, options, max_gray);
+
+        std::vector<cv::Mat> levels = {gray};
+        while (levels.size() <= options.pyramid_levels
+               && std::min(levels.back().rows, levels.back().cols) / 2 >= MIN_PYRAMID_SIZE
+               && (max_radius >> levels.size()) >= MIN_PYRAMID_RADIUS) {
+            levels.push_back(downsample(levels.back()));
+        }
+
+        std::vector<unsigned int> candidates;
+        unsigned int coarser_radius = 0;
+
+        for (size_t level = levels.size(); level-- > 0;) {
+            unsigned int scale = 1u << level;
+
+            // Distances shrink with the image => radii get scaled down as well (rounded, at least 1)
+            auto scaled = [scale](unsigned int r) { return std::max(1u, (r + scale / 2) / scale); };
+
+            Options level_options = options;
+            if (options.schedule == EXPLICIT) {
+                level_options.radii.clear();
+                for (unsigned int r : options.radii) {
+                    unsigned int radius = scaled(r);
+                    if (std::find(level_options.radii.begin(), level_options.radii.end(), radius)
+                            == level_options.radii.end()) {
+                        level_options.radii.push_back(radius);
+                    }
+                }
+            }
+
+            std::set<unsigned int> angles;
+            if (level + 1 == levels.size()) {
+                for (unsigned int angle = range.first; angle <= range.second; angle++) angles.insert(angle);
+            } else {
+                int refinement = static_cast<int>(options.refinement);
+
+                // Standard: integer offsets of a radius r only distinguish angles about atan(1/r) apart
+                if (impl == STANDARD) {
+                    refinement = std::max(refinement, static_cast<int>(std::ceil(std::atan(1.0 / coarser_radius)
+                                                                                 * 180 / CV_PI)));
+                }
+
+                for (unsigned int candidate : candidates) {
+                    unsigned int first = std::max<int>(range.first, static_cast<int>(candidate) - refinement);
+                    unsigned int last = std::min<int>(range.second, static_cast<int>(candidate) + refinement);
+                    for (unsigned int angle = first; angle <= last; angle++) angles.insert(angle);
+                }
+            }
+
+            std::vector<unsigned int> evaluated(angles.begin(), angles.end());
+            std::vector<double> dist = getAngleDistribution(levels[level], impl, scaled(max_radius), evaluated,
+                                                            level_options, max_gray);
+
+            std::vector<unsigned int> radii = radius_schedule(scaled(max_radius), level_options);
+            coarser_radius = radii.empty() ? 1 : *std::max_element(radii.begin(), radii.end());
+
+            std::map<unsigned int, double> values;
+            for (unsigned int i = 0; i < evaluated.size(); i++) values[evaluated[i]] = dist[i];
+
+            candidates = best_candidates(values, level == 0 ? 1 : options.candidates);
+        }
+
+        return candidates.front();
+    }
+
+
+    /**
+     *  Searches the dominant angle of a range as stated by options.search
+     *
+     *  @param image        the given image
+     *  @param impl         which implementation of the GLCM shall be used
+     *  @param max_radius   the given maximum radius
+     *  @param range        interval of angles to consider!
+     *  @param options      additional settings (which search is used)
+     *  @param max_gray     number of gray levels of an image already prepared, 0 => not prepared yet
+     *  @return             the dominant angle (in degrees!)
+     */
+    inline unsigned int search_angle(const cv::Mat& image, Implementation impl, unsigned int max_radius,
+                                      const Range& range, const Options& options, int max_gray = 0) {
+        switch (options.search) {
+            case COARSE_TO_FINE:
+                return coarse_to_fine_search(image, impl, max_radius, range, options, max_gray);
+            case PYRAMID:
+                return pyramid_search(image, impl, max_radius, range, options, max_gray);
+            case FULL:
+                break;
+        }
+
+        std::vector<double> orientation_distribution = getAngleDistribution(image, impl, max_radius, range, options,
+                                                                            max_gray);
+
+        return range.first + std::distance(
+                orientation_distribution.begin(),
+                std::min_element(orientation_distribution.begin(), orientation_distribution.end())
+        );
+    }
+}
+
+
+#endif //AIOLOS_SEARCH_H
@@ -0,0 +1,82 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#pragma once
+#ifndef AIOLOS_SPARSE_H
+#define AIOLOS_SPARSE_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <unordered_map>
+
+
+namespace GLCM {
+    /**
+     *  GLCM only storing the occupied cells (hashed), used instead of a dense matrix when even the occupied range of
+     *  gray values is too large (e.g. 16 bit images) => memory is bounded by the number of pairs, not by max_gray^2
+     *
+     *  @tparam C           count type of the GLCM: ushort, int (double only for huge images)
+     *
+     *  REVIEW: Same interface as cv::Mat_<C> as far as the kernels are concerned (rows, cols, operator())
+     */
+    template <typename C>
+    class SparseGLCM {
+    public:
+        using value_type = C;
+
+        int rows, cols;
+
+        SparseGLCM(int rows, int cols, C = C(0)) : rows(rows), cols(cols) {}
+
+        /// Count of the gray values i and j (created with 0 if not yet occupied)
+        C& operator()(int i, int j) {
+            return entries[static_cast<std::uint64_t>(i) * cols + j];
+        }
+
+        /// Removes every count (the buckets are kept for the next GLCM)
+        void clear() {
+            entries.clear();
+        }
+
+        /// Adds every count of another GLCM of the same size
+        void add(const SparseGLCM<C>& other) {
+            for (const auto& cell : other.entries) entries[cell.first] += cell.second;
+        }
+
+        /// All occupied cells (key: i * cols + j)
+        const std::unordered_map<std::uint64_t, C>& cells() const {
+            return entries;
+        }
+
+    private:
+        std::unordered_map<std::uint64_t, C> entries;
+    };
+
+
+    /**
+     *  Calculates the degree of concentration of a sparse GLCM (equals the Z-function from the paper)
+     *
+     *  @tparam C           count type of the GLCM: ushort, int (double only for huge images)
+     *  @param glcm         the GLCM, to work on
+     *  @return             the degree of concentration
+     *
+     *  REVIEW: Only the occupied cells get visited, same exact integer arithmetic as the dense version
+     */
+    template <typename C>
+    double concentration_degree(const SparseGLCM<C>& glcm) {
+        std::uint64_t value = 0;
+
+        for (const auto& cell : glcm.cells()) {
+            std::uint64_t diff = static_cast<std::uint64_t>(std::llabs(static_cast<long long>(cell.first / glcm.cols)
+                                                                         - static_cast<long long>(cell.first % glcm.cols)));
+            value += diff * diff * static_cast<std::uint64_t>(cell.second);
+        }
+
+        return static_cast<double>(value);
+    }
+}
+
+
+#endif //AIOLOS_SPARSE_H
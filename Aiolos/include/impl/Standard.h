@@ -7,6 +7,13 @@
 #ifndef AIOLOS_STANDARD_H
 #define AIOLOS_STANDARD_H
 
+#include <cstdint>
+#include <omp.h>
+#include <opencv2/opencv.hpp>
+
+#include "Offsets.h"
+#include "util/SimdFunctions.h"
+
 
 namespace GLCM {
     namespace Standard {
@@ -14,31 +21,66 @@ namespace GLCM {
          *  Creates the standard GLCM based on the given parameters
          *
          *  @tparam T           single channel type: char/uchar, short/ushort, int
+         *  @tparam G           storage of the GLCM: cv::Mat_<C> or GLCM::SparseGLCM<C> (C: ushort, int, double)
          *  @param image        the given image
          *  @param glcm         the matrix, the GLCM is stored to
-         *  @param r            the radius, the GLCM is based on
-         *  @param theta        the angle, the GLCM is based on (in radiant!)
+         *  @param offset       the offset (and weights) of the radius and angle, the GLCM is based on
+         *  @param rows         the band of rows, whose pixels (and their partners) are considered
          *
-         *  TODO: change x, y to int (and x2, y2 as well) to test for negative values!
+         *  REVIEW: Runs inside the work items of GLCM::calc_angle_dist => no parallel region of its own!
          */
-        template <typename T>
-        void GLCM(const cv::Mat_<T>& image, cv::Mat1d& glcm, double r, double theta) {
-            double dist_x = r*cos(theta);
-            double dist_y = r*sin(theta);
-
-            #pragma omp parallel for collapse(2) shared(dist_x, dist_y)
-            for (unsigned int y = 0; y < image.cols; y++) {
-                for (unsigned int x = 0; x < image.rows; x++) {
-                    unsigned int x2 = x + dist_x;
+        template <typename T, typename G>
+        void GLCM(const cv::Mat_<T>& image, G& glcm, const Offset& offset,
+                    const cv::Range& rows = cv::Range::all()) {
+            int dist_x = offset.dist_x, dist_y = offset.dist_y;
+
+            for (int y = std::max(0, rows.start); y < std::min(image.rows, rows.end); y++) {
+                for (int x = 0; x < image.cols; x++) {
+                    int x2 = x + dist_x;
                     if (x2 < 0 || x2 >= image.cols) continue;
 
-                    unsigned int y2 = y + dist_y;
+                    int y2 = y + dist_y;
                     if (y2 < 0 || y2 >= image.rows) continue;
 
                     glcm(image(y, x), image(y2, x2))++;
                 }
             }
         }
+
+
+        /**
+         *  Calculates the degree of concentration of the standard GLCM without creating it, therefore the squared
+         *  difference of every pair of gray values gets summed up directly: Z = Σ (i-j)^2 * P(i,j) = Σ (a-b)^2
+         *
+         *  @tparam T           single channel type: char/uchar, short/ushort, int
+         *  @param image        the given image
+         *  @param offset       the offset (and weights) of the radius and angle, the GLCM is based on
+         *  @param rows         the band of rows, whose pixels (and their partners) are considered
+         *  @param cols         the band of columns, whose pixels (and their partners) are considered
+         *  @return             the degree of concentration
+         */
+        template <typename T>
+        double concentration_degree(const cv::Mat_<T>& image, const Offset& offset,
+                                      const cv::Range& rows = cv::Range::all(),
+                                      const cv::Range& cols = cv::Range::all()) {
+            int dist_x = offset.dist_x, dist_y = offset.dist_y;
+
+            // Only pixels whose partner lies inside the image as well => no checks inside the loop needed
+            int y_begin = std::max({0, -dist_y, rows.start}), y_end = std::min({image.rows, image.rows - dist_y, rows.end});
+            int x_begin = std::max({0, -dist_x, cols.start}), x_end = std::min({image.cols, image.cols - dist_x, cols.end});
+
+            std::uint64_t value = 0;
+
+            if (x_begin >= x_end) return 0.0;
+
+            // Contiguous spans of both rows => vectorized kernel for 8 and 16 bit (see GLCM::Util::squared_differences)
+            for (int y = y_begin; y < y_end; y++) {
+                value += Util::squared_differences(image[y] + x_begin, image[y + dist_y] + x_begin + dist_x,
+                                                   x_end - x_begin);
+            }
+
+            return static_cast<double>(value);
+        }
     }
 }
 
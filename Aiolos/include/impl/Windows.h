@@ -0,0 +1,197 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#pragma once
+#ifndef AIOLOS_WINDOWS_H
+#define AIOLOS_WINDOWS_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+
+#include "Definitions.h"
+#include "Offsets.h"
+#include "Scheme3.h"
+
+
+namespace GLCM {
+    namespace Windows {
+        /**
+         *  Returns the pixels of a window, whose partner (Scheme 2 / 3: all four nearby points) lies inside the window
+         *  as well => the same pixels GLCM::getAngleDistribution considers for the window cut out of the image
+         *
+         *  @param window       the window (inside the image)
+         *  @param impl         which implementation of the GLCM is used
+         *  @param offset       the offset of the radius and angle
+         *  @return             the pixels (may be empty)
+         */
+        inline cv::Rect pairs_inside(const cv::Rect& window, Implementation impl, const Offset& offset) {
+            // Interpolating implementations need the partner + 1 in both directions
+            int extent = impl == STANDARD ? 0 : 1;
+
+            int x_begin = window.x + std::max(0, -offset.dist_x);
+            int x_end = window.x + window.width - std::max(0, offset.dist_x + extent);
+            int y_begin = window.y + std::max(0, -offset.dist_y);
+            int y_end = window.y + window.height - std::max(0, offset.dist_y + extent);
+
+            if (x_begin >= x_end || y_begin >= y_end) return cv::Rect();
+
+            return cv::Rect(x_begin, y_begin, x_end - x_begin, y_end - y_begin);
+        }
+
+
+        /**
+         *  Calculates the integral image of the squared difference of every pixel and its partner: the degree of
+         *  concentration of every rectangle of pixels is a lookup of its four corners afterwards
+         *
+         *  @tparam T           single channel type: char/uchar, short/ushort, int
+         *  @param image        the given image
+         *  @param impl         which implementation of the GLCM is used (STANDARD, SCHEME2 or SCHEME3)
+         *  @param offset       the offset (and weights) of the radius and angle
+         *  @param integral     the returned integral image ((rows + 1) x (cols + 1), reused, pixels without partner add 0)
+         *  @param partners     buffer for the partners of a row (reused)
+         *
+         *  REVIEW: Same partners as the DIFFERENCE engine of every implementation => same values, just summed up per pixel
+         *  REVIEW: Unsigned 64 bit integers => exact even for 16 bit images, every rectangle sum is just a difference
+         */
+        template <typename T>
+        void pair_differences(const cv::Mat_<T>& image, Implementation impl, const Offset& offset,
+                               std::vector<std::uint64_t>& integral, std::vector<T>& partners) {
+            int cols = image.cols + 1;
+            integral.assign(static_cast<size_t>(image.rows + 1) * cols, 0);
+
+            cv::Rect valid = pairs_inside(cv::Rect(0, 0, image.cols, image.rows), impl, offset);
+
+            for (int y = 0; y < image.rows; y++) {
+                const std::uint64_t* above = integral.data() + static_cast<size_t>(y) * cols;
+                std::uint64_t* current = integral.data() + static_cast<size_t>(y + 1) * cols;
+                std::uint64_t row_sum = 0;
+
+                bool inside = y >= valid.y && y < valid.y + valid.height;
+                const T* row = image[y];
+                const T* partner = nullptr;
+
+                if (inside && impl == SCHEME3) {
+                    partner = Scheme3::interpolate(image, offset, y, cv::Range(valid.x, valid.x + valid.width),
+                                                   partners) - valid.x;
+                } else if (inside && impl == STANDARD) {
+                    partner = image[y + offset.dist_y] + offset.dist_x;
+                }
+
+                for (int x = 0; x < image.cols; x++) {
+                    if (inside && x >= valid.x && x < valid.x + valid.width) {
+                        std::int64_t gray;
+
+                        if (impl == SCHEME2) {
+                            // Same (truncated) interpolation as GLCM::Scheme2
+                            const T* row_1 = image[y + offset.dist_y] + x + offset.dist_x;
+                            const T* row_2 = image[y + offset.dist_y + 1] + x + offset.dist_x;
+
+                            gray = static_cast<unsigned int>(offset.c_1 * row_1[0])
+                                   + static_cast<unsigned int>(offset.c_2 * row_1[1])
+                                   + static_cast<unsigned int>(offset.c_3 * row_2[0])
+                                   + static_cast<unsigned int>(offset.c_4 * row_2[1]);
+                        } else {
+                            gray = partner[x];
+                        }
+
+                        // Squared as unsigned (see GLCM::Util::squared_differences)
+                        std::int64_t diff = static_cast<std::int64_t>(row[x]) - gray;
+                        std::uint64_t d = static_cast<std::uint64_t>(diff < 0 ? -diff : diff);
+                        row_sum += d * d;
+                    }
+
+                    current[x + 1] = above[x + 1] + row_sum;
+                }
+            }
+        }
+
+
+        /**
+         *  Sums up a rectangle of an integral image
+         *
+         *  @param integral     the integral image ((rows + 1) x (cols + 1))
+         *  @param cols         number of columns of the image
+         *  @param rect         the rectangle (may be empty)
+         *  @return             the sum
+         */
+        inline std::uint64_t sum(const std::vector<std::uint64_t>& integral, int cols, const cv::Rect& rect) {
+            if (rect.width <= 0 || rect.height <= 0) return 0;
+
+            size_t stride = static_cast<size_t>(cols) + 1;
+            size_t top = static_cast<size_t>(rect.y) * stride, bottom = static_cast<size_t>(rect.y + rect.height) * stride;
+
+            return integral[bottom + rect.x + rect.width] - integral[bottom + rect.x]
+                   - integral[top + rect.x + rect.width] + integral[top + rect.x];
+        }
+
+
+        /**
+         *  Calculates the distribution of every window of an image: every (angle, radius) pair builds a single integral
+         *  image, the degree of concentration of every window is a lookup then (instead of scanning every window)
+         *
+         *  @tparam T                       single channel type: char/uchar, short/ushort, int
+         *  @param image                    the given image
+         *  @param impl                     which implementation of the GLCM shall be used (all but Scheme 1)
+         *  @param windows                  the windows (inside the image, may overlap)
+         *  @param radii                    the radii, which shall be considered
+         *  @param angles                   the angles, which shall be considered (in degrees!)
+         *  @param distributions            the returned values (windows.size() x angles.size(), one row per window)
+         *  @param max_radii                largest radius of every window, if empty every radius is used
+         *
+         *  REVIEW: Every angle is a work item of its own (writes its own column only) => no data race, the radii get
+         *          summed up as std::uint64_t (see GLCM::exact_sum) => same result independent of the number of threads
+         */
+        template <typename T>
+        void calc_distributions(const cv::Mat_<T>& image, Implementation impl, const std::vector<cv::Rect>& windows,
+                                 const std::vector<unsigned int>& radii, const std::vector<unsigned int>& angles,
+                                 std::vector<double>& distributions,
+                                 const std::vector<unsigned int>& max_radii = std::vector<unsigned int>()) {
+            if (impl == SCHEME1) {
+                throw std::invalid_argument("[GLCM::Windows::calc_distributions] SCHEME1 rotates every window on its own!");
+            }
+
+            long n_angles = static_cast<long>(angles.size());
+            long n_radii = static_cast<long>(radii.size());
+            distributions.assign(windows.size() * angles.size(), 0.0);
+
+            std::shared_ptr<const OffsetTable> offsets = offset_table(angles, radii);
+
+            #pragma omp parallel
+            {
+                std::vector<std::uint64_t> integral;
+                std::vector<T> partners;
+
+                std::vector<std::uint64_t> column;
+
+                #pragma omp for schedule(dynamic)
+                for (long theta = 0; theta < n_angles; theta++) {
+                    column.assign(windows.size(), 0);
+
+                    for (long i = 0; i < n_radii; i++) {
+                        const Offset& offset = (*offsets)[theta * n_radii + i];
+                        pair_differences(image, impl, offset, integral, partners);
+
+                        for (size_t w = 0; w < windows.size(); w++) {
+                            if (!max_radii.empty() && radii[i] > max_radii[w]) continue;
+
+                            column[w] += sum(integral, image.cols, pairs_inside(windows[w], impl, offset));
+                        }
+                    }
+
+                    // Written once per angle (not once per radius) => no false sharing of neighbouring angles, converted
+                    // to double only once every radius got summed up
+                    for (size_t w = 0; w < windows.size(); w++) {
+                        distributions[w * n_angles + theta] = static_cast<double>(column[w]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+#endif //AIOLOS_WINDOWS_H
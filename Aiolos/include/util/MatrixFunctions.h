@@ -24,17 +24,82 @@ namespace GLCM {
 
 
         /**
-         *  Splits image in 4 subimages to evaluate their angles
+         *  Quantizes the image to the given number of gray levels (keeps the highest bits of every gray value)
          *
          *  @param image        the given image
-         *  @param angles       the returned vector of found angles
+         *  @param levels       number of gray levels (power of 2, at most the number of possible gray values)
+         *  @return             the quantized image (CV_8U for up to 256 levels, CV_16U otherwise)
+         */
+        cv::Mat quantize(const cv::Mat& image, unsigned int levels);
+
+
+        /**
+         *  Quantizes the image to the given number of gray levels into a buffer, reused if size and type fit
+         *
+         *  @param image        the given image
+         *  @param levels       number of gray levels (power of 2, at most the number of possible gray values)
+         *  @param quantized    the quantized image (CV_8U for up to 256 levels, CV_16U otherwise)
+         */
+        void quantize(const cv::Mat& image, unsigned int levels, cv::Mat& quantized);
+
+
+        /**
+         *  Moves the gray values of the image to the range actually occupied (lowest gray value becomes 0)
+         *
+         *  @param image        the given image
+         *  @param levels       the returned number of occupied gray levels (highest - lowest gray value + 1)
+         *  @return             the compacted image (smallest unsigned type holding every gray value, CV_32S above)
+         */
+        cv::Mat compact(const cv::Mat& image, int& levels);
+
+
+        /**
+         *  Moves the gray values of the image to the range actually occupied into a buffer, reused if size and type fit
+         *
+         *  @param image        the given image
+         *  @param levels       the returned number of occupied gray levels (highest - lowest gray value + 1)
+         *  @param compacted    the compacted image (smallest unsigned type holding every gray value, CV_32S above)
+         */
+        void compact(const cv::Mat& image, int& levels, cv::Mat& compacted);
+
+
+        /**
+         *  Checks whether every degree of concentration of an image stays exact: a single Z is at most the squared
+         *  range of gray values times the number of pairs (at most the number of pixels), it has to fit into the 53
+         *  bit mantissa of a double (the radii of an angle get summed up as std::uint64_t afterwards)
+         *
+         *  @param range        highest - lowest gray value of the (prepared) image
+         *  @param pixels       number of pixels of the image
+         *
+         *  NOBUG:  Worst case only => wide 16 / 32 bit ranges of large images have to be quantized (Options::levels)
+         */
+        void check_exact_range(double range, size_t pixels);
+
+
+        /**
+         *  Splits an image into a grid of sub-images (every pixel belongs to exactly one of them, their sizes differ
+         *  by one pixel at most)
+         *
+         *  @param size         size of the given image
+         *  @param grid         number of sub-images in width and height
+         *  @return             the sub-images (row by row, every row left to right)
+         */
+        std::vector<cv::Rect> grid(const cv::Size& size, const cv::Size& grid);
+
+
+        /**
+         *  Splits image in subimages (see GLCM::Method) to evaluate their angles
+         *
+         *  @param image        the given image
+         *  @param angles       the returned vector of found angles (row by row, every row left to right)
          *  @param impl         which implementation of the GLCM shall be used
          *  @param meth         which of the splitting methods is used!
          *  @param range        interval of angles to consider!
          *  @param max_r        maximum radius
+         *  @param options      additional settings (e.g. which engine calculates the degree of concentration)
          */
         void split_image(const cv::Mat& image, std::vector<unsigned int>& angles, Implementation impl, Method meth,
-                            const Range& range, unsigned int max_r);
+                            const Range& range, unsigned int max_r, const Options& options);
 
     }
 }
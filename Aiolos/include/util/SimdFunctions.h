@@ -0,0 +1,139 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#pragma once
+#ifndef AIOLOS_SIMDFUNCTIONS_H
+#define AIOLOS_SIMDFUNCTIONS_H
+
+#include <cmath>
+#include <cstdint>
+#include <opencv2/opencv.hpp>
+
+
+/**
+ *  Every kernel for 8 and 16 bit exists once per instruction set, the best one for the CPU running the library gets
+ *  chosen once when the library is loaded (GCC function multiversioning, CPUID based). Other compilers and platforms
+ *  only get the default version.
+ */
+#if defined (__GNUC__) && !defined (__clang__) && (defined (__x86_64__) || defined (__i386__)) && !defined (_WIN32)
+#   define AIOLOS_TARGET_CLONES __attribute__ ((target_clones("arch=skylake-avx512", "avx2", "sse4.2", "default")))
+#else
+#   define AIOLOS_TARGET_CLONES
+#endif
+
+
+namespace GLCM {
+    namespace Util {
+        /**
+         *  Sums up the squared differences of two spans of gray values: Σ (a[i] - b[i])^2
+         *
+         *  @tparam T           single channel type: char/uchar, short/ushort, int
+         *  @param a            the first span
+         *  @param b            the second span
+         *  @param n            number of gray values in both spans
+         *  @return             the sum
+         *
+         *  REVIEW: Generic (scalar) version, 8 and 16 bit unsigned use the vectorized overloads below!
+         */
+        template <typename T>
+        std::uint64_t squared_differences(const T* a, const T* b, int n) {
+            std::uint64_t value = 0;
+
+            for (int i = 0; i < n; i++) {
+                // Squared as unsigned: the square of a 32 bit difference does not fit into std::int64_t
+                std::int64_t diff = static_cast<std::int64_t>(a[i]) - static_cast<std::int64_t>(b[i]);
+                std::uint64_t d = static_cast<std::uint64_t>(diff < 0 ? -diff : diff);
+                value += d * d;
+            }
+
+            return value;
+        }
+
+
+        /// Vectorized versions of GLCM::Util::squared_differences
+        std::uint64_t squared_differences(const uchar* a, const uchar* b, int n);
+        std::uint64_t squared_differences(const ushort* a, const ushort* b, int n);
+
+
+        /**
+         *  Sums up the squared differences of a span of gray values and their (truncated) interpolated partners, every
+         *  partner gets interpolated from its four nearby points (row_1[i], row_1[i+1], row_2[i], row_2[i+1])
+         *
+         *  @tparam T           single channel type: char/uchar, short/ushort, int
+         *  @param row          the span of gray values
+         *  @param row_1        the upper nearby points (n + 1 gray values)
+         *  @param row_2        the lower nearby points (n + 1 gray values)
+         *  @param n            number of gray values
+         *  @param c_1          weight of the upper left nearby point
+         *  @param c_2          weight of the upper right nearby point
+         *  @param c_3          weight of the lower left nearby point
+         *  @param c_4          weight of the lower right nearby point
+         *  @return             the sum
+         *
+         *  REVIEW: Generic (scalar) version, 8 and 16 bit unsigned use the vectorized overloads below!
+         */
+        template <typename T>
+        std::uint64_t interpolated_squared_differences(const T* row, const T* row_1, const T* row_2, int n,
+                                                       double c_1, double c_2, double c_3, double c_4) {
+            std::uint64_t value = 0;
+
+            for (int i = 0; i < n; i++) {
+                unsigned int gray = static_cast<unsigned int>(c_1 * row_1[i])
+                                    + static_cast<unsigned int>(c_2 * row_1[i + 1])
+                                    + static_cast<unsigned int>(c_3 * row_2[i])
+                                    + static_cast<unsigned int>(c_4 * row_2[i + 1]);
+
+                std::int64_t diff = static_cast<std::int64_t>(row[i]) - static_cast<std::int64_t>(gray);
+                std::uint64_t d = static_cast<std::uint64_t>(diff < 0 ? -diff : diff);
+                value += d * d;
+            }
+
+            return value;
+        }
+
+
+        /// Vectorized versions of GLCM::Util::interpolated_squared_differences
+        std::uint64_t interpolated_squared_differences(const uchar* row, const uchar* row_1, const uchar* row_2, int n,
+                                                       double c_1, double c_2, double c_3, double c_4);
+        std::uint64_t interpolated_squared_differences(const ushort* row, const ushort* row_1, const ushort* row_2,
+                                                       int n, double c_1, double c_2, double c_3, double c_4);
+
+
+        /**
+         *  Interpolates a span of partners from their four nearby points (row_1[i], row_1[i+1], row_2[i], row_2[i+1]),
+         *  the weighted gray values get summed up first and rounded only once
+         *
+         *  @tparam T           single channel type: char/uchar, short/ushort, int
+         *  @param row_1        the upper nearby points (n + 1 gray values)
+         *  @param row_2        the lower nearby points (n + 1 gray values)
+         *  @param n            number of partners
+         *  @param c_1          weight of the upper left nearby point
+         *  @param c_2          weight of the upper right nearby point
+         *  @param c_3          weight of the lower left nearby point
+         *  @param c_4          weight of the lower right nearby point
+         *  @param partners     the returned partners (n gray values)
+         *
+         *  REVIEW: Generic (scalar) version, 8 and 16 bit unsigned use the vectorized overloads below!
+         */
+        template <typename T>
+        void interpolate(const T* row_1, const T* row_2, int n, double c_1, double c_2, double c_3, double c_4,
+                         T* partners) {
+            for (int i = 0; i < n; i++) {
+                partners[i] = static_cast<T>(std::floor(c_1 * row_1[i] + c_2 * row_1[i + 1]
+                                                        + c_3 * row_2[i] + c_4 * row_2[i + 1] + 0.5));
+            }
+        }
+
+
+        /// Vectorized versions of GLCM::Util::interpolate
+        void interpolate(const uchar* row_1, const uchar* row_2, int n, double c_1, double c_2, double c_3, double c_4,
+                         uchar* partners);
+        void interpolate(const ushort* row_1, const ushort* row_2, int n, double c_1, double c_2, double c_3,
+                         double c_4, ushort* partners);
+    }
+}
+
+
+#endif //AIOLOS_SIMDFUNCTIONS_H
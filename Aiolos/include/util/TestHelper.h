@@ -0,0 +1,124 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+#pragma once
+#ifndef AIOLOS_TESTHELPER_H
+#define AIOLOS_TESTHELPER_H
+
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <initializer_list>
+#include <opencv2/opencv.hpp>
+
+#include "Aiolos.h"
+
+
+/**
+ *  Creates stripes of a given orientation plus a little deterministic noise, a texture with a distinct dominant angle
+ *
+ *  @tparam T                   single channel type of the image
+ *  @tparam Angle               callable (int x, int y) returning the orientation of the stripes at every pixel
+ *  @param size                 the size of the image
+ *  @param angle_at             orientation of the stripes (in degrees)
+ *  @param mean                 gray value, the stripes oscillate around
+ *  @param amplitude            amplitude of the stripes
+ *  @param frequency            frequency of the stripes (in radiant per pixel)
+ *  @param noise                the noise added: (7x + 13y) mod noise
+ *  @return                     the texture
+ */
+template <typename T, typename Angle>
+cv::Mat_<T> stripes(const cv::Size& size, Angle angle_at, double mean, double amplitude, double frequency, int noise) {
+    cv::Mat_<T> image(size);
+
+    for (int y = 0; y < image.rows; y++) {
+        for (int x = 0; x < image.cols; x++) {
+            double theta = angle_at(x, y) * CV_PI / 180;
+            image(y, x) = cv::saturate_cast<T>(mean + amplitude * std::sin((-x * std::sin(theta) + y * std::cos(theta))
+                                                                             * frequency) + (x * 7 + y * 13) % noise);
+        }
+    }
+
+    return image;
+}
+
+
+/**
+ *  Creates 8 bit stripes of a single orientation (the texture shared by most of the tests)
+ *
+ *  @param size                 the size of the image
+ *  @param angle                orientation of the stripes (in degrees)
+ *  @return                     the texture
+ */
+inline cv::Mat_<uchar> stripes(const cv::Size& size, double angle = 35) {
+    return stripes<uchar>(size, [=](int, int) { return angle; }, 127, 100, 0.6, 5);
+}
+
+
+/**
+ *  Calculates the distribution of the given angles using the C interface (see aiolos_angle_distribution)
+ *
+ *  @param image                the given image (8 / 16 bit unsigned or 32 bit signed)
+ *  @param options              the settings (see aiolos_default_options)
+ *  @return                     one value per angle of the range, empty if the calculation failed (error printed)
+ */
+inline std::vector<double> c_distribution(const cv::Mat& image, const aiolos_options& options) {
+    aiolos_image raw;
+    raw.data = image.data;
+    raw.width = image.cols;
+    raw.height = image.rows;
+    raw.stride = image.step;
+    raw.format = image.depth() == CV_32S ? AIOLOS_GRAY32S : (image.depth() == CV_16U ? AIOLOS_GRAY16 : AIOLOS_GRAY8);
+
+    std::vector<double> values(options.last_angle - options.first_angle + 1);
+    if (aiolos_angle_distribution(&raw, &options, values.data(), values.size()) != AIOLOS_OK) {
+        std::cout << aiolos_last_error() << std::endl;
+        values.clear();
+    }
+
+    return values;
+}
+
+
+/**
+ *  Calculates the distribution of every angle (0 ... 179) using the C interface
+ *
+ *  @param image                the given image (8 / 16 bit unsigned or 32 bit signed)
+ *  @param impl                 which implementation of the GLCM shall be used
+ *  @param engine               which engine calculates the degree of concentration
+ *  @param levels               number of gray levels the image gets quantized to (0 => none)
+ *  @param max_r                fixed maximum radius
+ *  @return                     one value per angle, empty if the calculation failed (error printed)
+ */
+inline std::vector<double> c_distribution(const cv::Mat& image, int impl, int engine, unsigned int levels,
+                                          unsigned int max_r) {
+    aiolos_options options;
+    aiolos_default_options(&options);
+    options.implementation = impl;
+    options.engine = engine;
+    options.levels = levels;
+    options.max_r = max_r;
+
+    return c_distribution(image, options);
+}
+
+
+/**
+ *  Prints the result of a single check of a test: its description and "gleich" / "FEHLER"
+ *
+ *  @tparam Parts               printable types
+ *  @param same                 whether the check passed
+ *  @param parts                the description of the check (printed one after another)
+ *  @return                     whether the check passed
+ */
+template <typename... Parts>
+bool report(bool same, const Parts&... parts) {
+    (void) std::initializer_list<int>{(std::cout << parts, 0)...};
+    std::cout << ": " << (same ? "gleich" : "FEHLER") << std::endl;
+
+    return same;
+}
+
+
+#endif //AIOLOS_TESTHELPER_H
@@ -2,6 +2,7 @@
 #include <chrono>
 #include <opencv2/opencv.hpp>
 #include <GLCM.h>
+#include <Tracker.h>
 
 #include "util/VisualizationHelper.h"
 
@@ -92,6 +93,9 @@ int main2() {
         return 1;
     }
 
+    // Orientation changes slowly between frames => only a window around the previous angle gets searched
+    GLCM::Tracker tracker(GLCM::STANDARD, GLCM::Range(10, 70), 50);
+
     Mat frame;
     for (;;) {
         cap >> frame;
@@ -103,7 +107,7 @@ int main2() {
         if (frame.channels() != 1) cvtColor(frame, frame, COLOR_BGR2GRAY);
 
         auto begin = chrono::steady_clock::now();
-        unsigned int main_angle = GLCM::main_angle(frame, GLCM::STANDARD, GLCM::Range(10, 70), 50);
+        unsigned int main_angle = tracker.update(frame);
         cout << "Std-Dauer: " << chrono::duration_cast<chrono::seconds>(chrono::steady_clock::now()-begin).count() << " Sec" << endl;
 
         cout << "Haupt-Orientierung: Std: " << main_angle << "°" << endl;
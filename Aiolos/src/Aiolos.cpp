@@ -0,0 +1,321 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#include <string>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+#include "util/MatrixFunctions.h"
+#include "impl/Distribution.h"
+#include "GLCM.h"
+#include "Estimator.h"
+#include "Aiolos.h"
+
+
+/// Estimator behind the opaque handle of the C interface
+struct aiolos_estimator {
+    aiolos_estimator(GLCM::Implementation impl, const GLCM::Range& range, unsigned int max_r,
+                     const GLCM::Options& options)
+            : estimator(impl, range, max_r, options), angles(range.second - range.first + 1) {}
+
+    GLCM::Estimator estimator;
+    size_t angles;                          // number of angles of the range (size of the distribution)
+};
+
+
+/***********************************************************************************************************************
+ *
+ *      Private helper functions
+ *
+ ***********************************************************************************************************************/
+
+namespace {
+    /// Message of the last error of every thread (returned by aiolos_last_error)
+    thread_local std::string last_error;
+
+
+    /**
+     *  Wraps the buffer of the caller (no copy)
+     *
+     *  @param image        the image of the caller
+     *  @return             the image sharing the buffer of the caller
+     */
+    cv::Mat wrap(const aiolos_image* image) {
+        if (image == nullptr || image->data == nullptr) {
+            throw std::invalid_argument("[aiolos] Image and its data must not be NULL!");
+        }
+
+        if (image->width <= 0 || image->height <= 0) {
+            throw std::invalid_argument("[aiolos] Width and height of the image have to be positive!");
+        }
+
+        int type;
+        switch (image->format) {
+            case AIOLOS_GRAY8:
+                type = CV_8UC1;
+                break;
+            case AIOLOS_GRAY8S:
+                type = CV_8SC1;
+                break;
+            case AIOLOS_GRAY16:
+                type = CV_16UC1;
+                break;
+            case AIOLOS_GRAY16S:
+                type = CV_16SC1;
+                break;
+            case AIOLOS_GRAY32S:
+                type = CV_32SC1;
+                break;
+            default:
+                throw std::invalid_argument("[aiolos] Unsupported pixel format!");
+        }
+
+        size_t row_bytes = static_cast<size_t>(image->width) * CV_ELEM_SIZE(type);
+        if (image->stride != 0 && (image->stride < row_bytes || image->stride % CV_ELEM_SIZE1(type) != 0)) {
+            throw std::invalid_argument("[aiolos] Stride has to hold a whole row (multiple of the pixel size)!");
+        }
+
+        // Only read => const_cast is fine, cv::Mat just has no read-only header
+        return cv::Mat(image->height, image->width, type, const_cast<void*>(image->data),
+                       image->stride != 0 ? image->stride : static_cast<size_t>(cv::Mat::AUTO_STEP));
+    }
+
+
+    /**
+     *  Converts the settings of the caller
+     *
+     *  @param settings     the settings of the caller or NULL => default values
+     *  @param impl         the returned implementation
+     *  @param range        the returned range of angles
+     *  @return             the options
+     */
+    GLCM::Options convert(const aiolos_options* settings, GLCM::Implementation& impl, GLCM::Range& range) {
+        aiolos_options defaults;
+        aiolos_default_options(&defaults);
+        const aiolos_options& s = settings != nullptr ? *settings : defaults;
+
+        if (s.implementation < GLCM::STANDARD || s.implementation > GLCM::SCHEME3) {
+            throw std::invalid_argument("[aiolos] Unknown implementation!");
+        }
+
+        if (s.first_angle > s.last_angle || s.last_angle > 179) {
+            throw std::invalid_argument("[aiolos] Range of angles has to be inside of 0 ... 179!");
+        }
+
+        if (s.engine < GLCM::MATRIX || s.engine > GLCM::AUTOCORRELATION) {
+            throw std::invalid_argument("[aiolos] Unknown engine!");
+        }
+
+        if (s.search < GLCM::FULL || s.search > GLCM::PYRAMID) throw std::invalid_argument("[aiolos] Unknown search!");
+
+        // EXPLICIT needs a list of radii => not part of the C interface
+        if (s.schedule < GLCM::EVERY_RADIUS || s.schedule > GLCM::GEOMETRIC) {
+            throw std::invalid_argument("[aiolos] Unknown schedule!");
+        }
+
+        impl = static_cast<GLCM::Implementation>(s.implementation);
+        range = GLCM::Range(s.first_angle, s.last_angle);
+
+        GLCM::Options options;
+        options.engine = static_cast<GLCM::Engine>(s.engine);
+        options.levels = s.levels;
+        options.search = static_cast<GLCM::Search>(s.search);
+        options.schedule = static_cast<GLCM::Schedule>(s.schedule);
+        options.stride = s.stride;
+        options.factor = s.factor;
+        options.tile_size = s.tile_size;
+
+        return options;
+    }
+
+
+    /**
+     *  Calls the function, every exception gets converted to a status (no exception must leave the C interface)
+     *
+     *  @param function     the function returning the status
+     *  @return             the status
+     */
+    template <typename F>
+    aiolos_status guarded(F function) {
+        last_error.clear();
+
+        try {
+            return function();
+        } catch (const std::invalid_argument& e) {
+            last_error = e.what();
+            return AIOLOS_INVALID_ARGUMENT;
+        } catch (const std::exception& e) {
+            last_error = e.what();
+            return AIOLOS_ERROR;
+        } catch (...) {
+            last_error = "[aiolos] Unknown error!";
+            return AIOLOS_ERROR;
+        }
+    }
+}
+
+
+
+/***********************************************************************************************************************
+ *
+ *      Actual implementation of the functions
+ *
+ ***********************************************************************************************************************/
+
+/// Fills the options with the default values.
+void aiolos_default_options(aiolos_options* options) {
+    if (options == nullptr) return;
+
+    const GLCM::Options defaults;
+
+    options->implementation = GLCM::STANDARD;
+    options->first_angle = 0;
+    options->last_angle = 179;
+    options->max_r = 0;
+    options->engine = defaults.engine;
+    options->levels = defaults.levels;
+    options->search = defaults.search;
+    options->schedule = defaults.schedule;
+    options->stride = defaults.stride;
+    options->factor = defaults.factor;
+    options->tile_size = defaults.tile_size;
+}
+
+
+/// Calculates the dominant angle of an image in the buffer of the caller.
+aiolos_status aiolos_main_angle(const aiolos_image* image, const aiolos_options* options, unsigned int* angle) {
+    return guarded([&]() {
+        if (angle == nullptr) throw std::invalid_argument("[aiolos_main_angle] Angle must not be NULL!");
+
+        GLCM::Implementation impl;
+        GLCM::Range range;
+        GLCM::Options converted = convert(options, impl, range);
+
+        *angle = GLCM::main_angle(wrap(image), impl, range, options != nullptr ? options->max_r : 0, converted);
+        return AIOLOS_OK;
+    });
+}
+
+
+/// Calculates the distribution of an image in the buffer of the caller, written into the buffer of the caller.
+aiolos_status aiolos_angle_distribution(const aiolos_image* image, const aiolos_options* options,
+                                        double* distribution, size_t capacity) {
+    return guarded([&]() {
+        if (distribution == nullptr) {
+            throw std::invalid_argument("[aiolos_angle_distribution] Distribution must not be NULL!");
+        }
+
+        GLCM::Implementation impl;
+        GLCM::Range range;
+        GLCM::Options converted = convert(options, impl, range);
+
+        // Checked before calculating anything
+        if (capacity < static_cast<size_t>(range.second - range.first + 1)) {
+            last_error = "[aiolos_angle_distribution] Buffer too small for every angle of the range!";
+            return AIOLOS_BUFFER_TOO_SMALL;
+        }
+
+        cv::Mat wrapped = wrap(image);
+        unsigned int max_radius = GLCM::max_radius_of(wrapped.size(), options != nullptr ? options->max_r : 0);
+
+        std::vector<unsigned int> angles(range.second - range.first + 1);
+        std::iota(angles.begin(), angles.end(), static_cast<unsigned int>(range.first));
+
+        GLCM::getAngleDistribution(wrapped, impl, max_radius, angles, converted, distribution);
+        return AIOLOS_OK;
+    });
+}
+
+
+/// Calculates the dominant angles of an image in the buffer of the caller, written into the buffer of the caller.
+aiolos_status aiolos_main_angles(const aiolos_image* image, const aiolos_options* options, int method,
+                                 unsigned int* angles, size_t capacity, size_t* count) {
+    return guarded([&]() {
+        if (count == nullptr || (angles == nullptr && capacity != 0)) {
+            throw std::invalid_argument("[aiolos_main_angles] Angles and count must not be NULL!");
+        }
+
+        if (method < GLCM::SPLIT_IMAGE_1x2 || method > GLCM::TOP_3) {
+            throw std::invalid_argument("[aiolos_main_angles] Unknown method!");
+        }
+
+        GLCM::Implementation impl;
+        GLCM::Range range;
+        GLCM::Options converted = convert(options, impl, range);
+
+        std::vector<unsigned int> result = GLCM::main_angles(wrap(image), impl, static_cast<GLCM::Method>(method),
+                                                             range, options != nullptr ? options->max_r : 0,
+                                                             converted);
+
+        *count = result.size();
+        if (result.size() > capacity) {
+            last_error = "[aiolos_main_angles] Buffer too small for every angle!";
+            return AIOLOS_BUFFER_TOO_SMALL;
+        }
+
+        std::copy(result.begin(), result.end(), angles);
+        return AIOLOS_OK;
+    });
+}
+
+
+/// Creates an estimator using the settings of the caller.
+aiolos_status aiolos_estimator_create(const aiolos_options* options, aiolos_estimator** estimator) {
+    return guarded([&]() {
+        if (estimator == nullptr) throw std::invalid_argument("[aiolos_estimator_create] Estimator must not be NULL!");
+
+        GLCM::Implementation impl;
+        GLCM::Range range;
+        GLCM::Options converted = convert(options, impl, range);
+
+        *estimator = new aiolos_estimator(impl, range, options != nullptr ? options->max_r : 0, converted);
+        return AIOLOS_OK;
+    });
+}
+
+
+/// Calculates the dominant angle of an image in the buffer of the caller using the estimator.
+aiolos_status aiolos_estimator_estimate(aiolos_estimator* estimator, const aiolos_image* image, unsigned int* angle) {
+    return guarded([&]() {
+        if (estimator == nullptr || angle == nullptr) {
+            throw std::invalid_argument("[aiolos_estimator_estimate] Estimator and angle must not be NULL!");
+        }
+
+        *angle = estimator->estimator.estimate(wrap(image));
+        return AIOLOS_OK;
+    });
+}
+
+
+/// Calculates the distribution of an image in the buffer of the caller using the estimator, no copy.
+aiolos_status aiolos_estimator_distribution(aiolos_estimator* estimator, const aiolos_image* image,
+                                            double* distribution, size_t capacity) {
+    return guarded([&]() {
+        if (estimator == nullptr || distribution == nullptr) {
+            throw std::invalid_argument("[aiolos_estimator_distribution] Estimator and distribution must not be NULL!");
+        }
+
+        if (capacity < estimator->angles) {
+            last_error = "[aiolos_estimator_distribution] Buffer too small for every angle of the range!";
+            return AIOLOS_BUFFER_TOO_SMALL;
+        }
+
+        estimator->estimator.distribution(wrap(image), distribution);
+        return AIOLOS_OK;
+    });
+}
+
+
+/// Frees the estimator.
+void aiolos_estimator_destroy(aiolos_estimator* estimator) {
+    delete estimator;
+}
+
+
+/// Returns the message of the last error of the calling thread.
+const char* aiolos_last_error(void) {
+    return last_error.c_str();
+}
@@ -0,0 +1,313 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#include <vector>
+#include <memory>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <omp.h>
+
+#include "util/MatrixFunctions.h"
+#include "impl/Distribution.h"
+#include "impl/Search.h"
+#include "Estimator.h"
+
+
+/// Everything the estimator keeps from one call to the next
+struct GLCM::Estimator::Context {
+    /// Scratch memory of a single worker thread
+    struct Scratch {
+        cv::Mat rotated;                    // rotated image (Scheme 1 only)
+        std::vector<cv::Range> spans;
+    };
+
+    int threads = 1;                        // size of the team, fixed => scratch memory indexed by the thread number
+    bool direct = true;                     // whether the distribution can be calculated using the scratch memory
+    std::vector<unsigned int> angles;
+    std::vector<Scratch> scratch;
+    cv::Mat prepared;                       // quantized / compacted image (if the image gets changed)
+
+    // Depending on the size of the image only
+    cv::Size size;
+    std::vector<unsigned int> radii;
+    std::shared_ptr<const OffsetTable> offsets;
+    int bands = 1, band_height = 0;
+    std::vector<double> values;             // Z of every work item (angles x radii x bands)
+    std::vector<double> distribution;
+};
+
+
+
+/***********************************************************************************************************************
+ *
+ *      Private helper functions
+ *
+ ***********************************************************************************************************************/
+
+namespace {
+    /**
+     *  Calculates Z of every work item of Scheme 1: every angle rotates the image once (into the buffer of the thread),
+     *  all of its radii work on that rotation. With fewer angles than threads all angles get rotated first (into the
+     *  buffers of the scratch memory with the same index), afterwards every (angle, radius) pair and band of rotated
+     *  rows is a work item of its own.
+     *
+     *  @tparam C           count type of the GLCM: ushort, int, double
+     *  @tparam T           single channel type: char/uchar, short/ushort, int
+     *  @param image        the prepared image
+     *  @param engine       which engine calculates the degree of concentration
+     *  @param max_gray     size of the GLCM
+     *  @param context      the context of the estimator (values get stored to it)
+     */
+    template <typename C, typename T>
+    void calc_rotated(const cv::Mat_<T>& image, GLCM::Engine engine, int max_gray, GLCM::Estimator::Context& context) {
+        long n_angles = static_cast<long>(context.angles.size()), n_radii = static_cast<long>(context.radii.size());
+
+        if (n_angles >= context.threads) {
+            #pragma omp parallel num_threads(context.threads)
+            {
+                GLCM::Estimator::Context::Scratch& scratch = context.scratch[omp_get_thread_num()];
+
+                // Buffers of the thread handed over to the rotation and back afterwards
+                GLCM::Scheme1::Rotation<T> rotation;
+                rotation.image = scratch.rotated;
+                rotation.spans.swap(scratch.spans);
+
+                #pragma omp for schedule(dynamic)
+                for (long theta = 0; theta < n_angles; theta++) {
+                    GLCM::Scheme1::rotate(image, context.angles[theta] * CV_PI / 180, rotation);
+
+                    for (long i = 0; i < n_radii; i++) {
+                        context.values[theta * n_radii + i] = GLCM::calc_rotated_degree<cv::Mat_<C>>(
+                                rotation, engine, max_gray, static_cast<int>(context.radii[i]));
+                    }
+                }
+
+                scratch.rotated = rotation.image;
+                rotation.spans.swap(scratch.spans);
+            }
+
+            return;
+        }
+
+        // Buffers of the scratch memory handed over to the rotations and back afterwards
+        std::vector<GLCM::Scheme1::Rotation<T>> rotations(n_angles);
+        for (long theta = 0; theta < n_angles; theta++) {
+            rotations[theta].image = context.scratch[theta].rotated;
+            rotations[theta].spans.swap(context.scratch[theta].spans);
+        }
+
+        long items = static_cast<long>(context.values.size());
+        int bands = context.bands, band_height = context.band_height;
+
+        #pragma omp parallel num_threads(context.threads)
+        {
+            #pragma omp for schedule(dynamic)
+            for (long theta = 0; theta < n_angles; theta++) {
+                GLCM::Scheme1::rotate(image, context.angles[theta] * CV_PI / 180, rotations[theta]);
+            }
+
+            #pragma omp for schedule(dynamic)
+            for (long item = 0; item < items; item++) {
+                long pair = item / bands;
+                int band = static_cast<int>(item % bands);
+                const GLCM::Scheme1::Rotation<T>& rotation = rotations[pair / n_radii];
+                cv::Range rows(band * band_height, std::min(rotation.image.rows, (band + 1) * band_height));
+
+                context.values[item] = GLCM::calc_rotated_degree<cv::Mat_<C>>(
+                        rotation, engine, max_gray, static_cast<int>(context.radii[pair % n_radii]), rows);
+            }
+        }
+
+        for (long theta = 0; theta < n_angles; theta++) {
+            context.scratch[theta].rotated = rotations[theta].image;
+            rotations[theta].spans.swap(context.scratch[theta].spans);
+        }
+    }
+
+
+    /**
+     *  Calculates Z of every work item (angle, radius and band of rows), dynamically distributed over the threads
+     *
+     *  @tparam C           count type of the GLCM: ushort, int, double
+     *  @tparam T           single channel type: char/uchar, short/ushort, int
+     *  @param image        the prepared image
+     *  @param impl         which implementation of the GLCM shall be used (all but Scheme 1)
+     *  @param engine       which engine calculates the degree of concentration
+     *  @param max_gray     size of the GLCM
+     *  @param context      the context of the estimator (values get stored to it)
+     *
+     *  REVIEW: Z is linear in the pairs counted => the GLCM of every band gets its own Z, no merging needed
+     */
+    template <typename C, typename T>
+    void calc_items(const cv::Mat_<T>& image, GLCM::Implementation impl, GLCM::Engine engine, int max_gray,
+                    GLCM::Estimator::Context& context) {
+        long items = static_cast<long>(context.values.size());
+        int bands = context.bands, band_height = context.band_height;
+
+        #pragma omp parallel for schedule(dynamic) num_threads(context.threads)
+        for (long item = 0; item < items; item++) {
+            const GLCM::Offset& offset = (*context.offsets)[item / bands];
+            int band = static_cast<int>(item % bands);
+            cv::Range rows(band * band_height, std::min(image.rows, (band + 1) * band_height));
+
+            context.values[item] = GLCM::calc_concentration_degree<cv::Mat_<C>>(image, impl, engine, max_gray, offset,
+                                                                                rows);
+        }
+    }
+}
+
+
+
+/***********************************************************************************************************************
+ *
+ *      Actual implementation of the functions
+ *
+ ***********************************************************************************************************************/
+
+GLCM::Estimator::Estimator(Implementation impl, const Range& range, unsigned int max_r, const Options& options)
+        : impl(impl), range(range), max_r(max_r), options(options), context(new Context()) {
+    if (range.first > range.second || range.second > 179) {
+        throw std::invalid_argument("[GLCM::Estimator] Range has to be inside of 0 ... 179!");
+    }
+
+    if (options.engine == AUTOCORRELATION && impl != STANDARD) {
+        throw std::invalid_argument("[GLCM::Estimator] AUTOCORRELATION only supports STANDARD implementation!");
+    }
+
+    context->direct = options.engine != AUTOCORRELATION && options.stable_radii == 0 && options.tile_size == 0;
+
+    context->threads = omp_get_max_threads();
+    context->scratch.resize(context->threads);
+
+    context->angles.resize(range.second - range.first + 1);
+    std::iota(context->angles.begin(), context->angles.end(), static_cast<unsigned int>(range.first));
+    context->distribution.resize(context->angles.size());
+}
+
+
+GLCM::Estimator::~Estimator() = default;
+
+
+/// Quantizes / compacts the image into the buffer of the context (see GLCM::prepare_image).
+const cv::Mat& GLCM::Estimator::prepare(const cv::Mat& image, int& max_gray) {
+    if (options.levels != 0) {
+        Util::check_exact_range(options.levels - 1.0, image.total());
+        max_gray = static_cast<int>(options.levels);
+        Util::quantize(image, options.levels, context->prepared);
+        return context->prepared;
+    }
+
+    int depth = image.type() & CV_MAT_DEPTH_MASK;
+
+    if (depth == CV_8U) {
+        max_gray = Util::max_gray_value(image);
+        return image;
+    }
+
+    // Same as GLCM::prepare_image: compacted for the MATRIX engine (or negative gray values) only
+    if (options.engine == MATRIX || depth != CV_16U) {
+        Util::compact(image, max_gray, context->prepared);
+        return context->prepared;
+    }
+
+    double min = 0, max = 0;
+    if (!image.empty()) cv::minMaxLoc(image, &min, &max);
+
+    Util::check_exact_range(max - min, image.total());
+    max_gray = static_cast<int>(max) + 1;
+    return image;
+}
+
+
+/// Calculates the distribution of the prepared image using the scratch memory of the estimator.
+void GLCM::Estimator::calculate(const cv::Mat& gray, int max_gray, double* distribution) {
+    Context& c = *context;
+    unsigned int max_radius = max_radius_of(gray.size(), max_r);
+
+    if (!c.direct || (options.engine == MATRIX && max_gray > MAX_DENSE_GRAY_LEVELS)) {
+        getAngleDistribution(gray, impl, max_radius, c.angles, options, distribution, max_gray);
+        return;
+    }
+
+    // Another size => radii, offsets and work items change (the only allocations after the first image)
+    if (c.size != gray.size() || c.values.empty()) {
+        c.size = gray.size();
+        c.radii = radius_schedule(max_radius, options);
+        c.offsets = offset_table(c.angles, c.radii);
+
+        // Same split into bands as GLCM::calc_values_impl: enough work items to keep every thread busy (Scheme 1:
+        // bands of the rotated rows, only with fewer angles than threads)
+        long pairs = static_cast<long>(c.offsets->size());
+        int rows = impl == SCHEME1 ? Scheme1::rotated_side(gray.size()) : gray.rows;
+        bool banded = impl != SCHEME1 || static_cast<long>(c.angles.size()) < c.threads;
+
+        c.bands = banded ? band_count(pairs, rows, c.threads) : 1;
+        c.band_height = (rows + c.bands - 1) / c.bands;
+        c.values.assign(pairs * c.bands, 0.0);
+    }
+
+    with_image_type(gray, [&](const auto& typed) {
+        typedef typename std::decay<decltype(typed)>::type::value_type T;
+
+        auto calculate = [&](auto count) {
+            typedef decltype(count) C;
+
+            if (impl == SCHEME1) calc_rotated<C, T>(typed, options.engine, max_gray, c);
+            else calc_items<C, T>(typed, impl, options.engine, max_gray, c);
+        };
+
+        // Every count is at most the number of pixels => smallest integer type holding it (see GLCM::with_storage)
+        if (typed.total() <= std::numeric_limits<ushort>::max()) {
+            calculate(ushort());
+        } else if (typed.total() <= static_cast<size_t>(std::numeric_limits<int>::max())) {
+            calculate(int());
+        } else {
+            calculate(double());
+        }
+    });
+
+    // Every Z is an integer => summed up as std::uint64_t, same sums as GLCM::calc_angle_dist (see GLCM::exact_sum)
+    long per_angle = static_cast<long>(c.radii.size()) * c.bands;
+    for (size_t theta = 0; theta < c.angles.size(); theta++) {
+        const double* first = c.values.data() + theta * per_angle;
+        distribution[theta] = exact_sum(first, first + per_angle);
+    }
+
+    if (options.statistics != nullptr) {
+        options.statistics->angles += c.angles.size();
+        options.statistics->radii += c.radii.size();
+    }
+}
+
+
+/// Calculates the dominant angle using the scratch memory of the estimator.
+unsigned int GLCM::Estimator::estimate(const cv::Mat& image) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Context& c = *context;
+
+    int max_gray = 0;
+    const cv::Mat& gray = prepare(image, max_gray);
+
+    if (options.search != FULL) {
+        return search_angle(gray, impl, max_radius_of(gray.size(), max_r), range, options, max_gray);
+    }
+
+    calculate(gray, max_gray, c.distribution.data());
+
+    return range.first + std::distance(c.distribution.begin(),
+                                       std::min_element(c.distribution.begin(), c.distribution.end()));
+}
+
+
+/// Calculates the distribution using the scratch memory of the estimator.
+void GLCM::Estimator::distribution(const cv::Mat& image, double* distribution) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    int max_gray = 0;
+    const cv::Mat& gray = prepare(image, max_gray);
+
+    calculate(gray, max_gray, distribution);
+}
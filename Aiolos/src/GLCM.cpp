@@ -8,9 +8,153 @@
 #include "util/VectorFunctions.h"
 #include "util/MatrixFunctions.h"
 #include "impl/Distribution.h"
+#include "impl/Search.h"
+#include "impl/Batch.h"
+#include "impl/Windows.h"
+#include "impl/Features.h"
 #include "GLCM.h"
 
 
+/***********************************************************************************************************************
+ *
+ *      Private helper functions
+ *
+ ***********************************************************************************************************************/
+
+namespace {
+    /**
+     *  Calculates the distribution of every window of the image from one pass over the image
+     *
+     *  @param image                the given image
+     *  @param impl                 which implementation of the GLCM shall be used (all but Scheme 1)
+     *  @param windows              the windows (inside the image)
+     *  @param angles               the angles, which shall be considered (in degrees!)
+     *  @param radii                the radii, which shall be considered
+     *  @param max_radii            largest radius of every window, if empty every radius is used
+     *  @param options              additional settings (levels)
+     *  @return                     the values (windows.size() x angles.size(), one row per window)
+     *
+     *  REVIEW: Only the bounding rectangle of the windows gets prepared and scanned, no halo needed: every pair of a
+     *          window lies inside of the window (see GLCM::Windows::pairs_inside)
+     *  NOBUG:  Prepared as for the DIFFERENCE engine (every window only sums up differences) => images deeper than
+     *          8 bit get compacted if signed only, see GLCM::main_angle_rois for Scheme 2
+     */
+    std::vector<double> window_distributions(const cv::Mat& image, GLCM::Implementation impl,
+                                              const std::vector<cv::Rect>& windows,
+                                              const std::vector<unsigned int>& angles,
+                                              const std::vector<unsigned int>& radii,
+                                              const std::vector<unsigned int>& max_radii,
+                                              const GLCM::Options& options) {
+        std::vector<double> distributions;
+        if (windows.empty()) return distributions;
+
+        cv::Rect bounds = windows.front();
+        for (const cv::Rect& window : windows) bounds |= window;
+
+        std::vector<cv::Rect> shifted(windows);
+        for (cv::Rect& window : shifted) window -= bounds.tl();
+
+        GLCM::Options difference = options;
+        difference.engine = GLCM::DIFFERENCE;
+
+        int max_gray = 0;
+        cv::Mat gray = GLCM::prepare_image(image(bounds), difference, max_gray);
+
+        GLCM::with_image_type(gray, [&](const auto& typed) {
+            GLCM::Windows::calc_distributions(typed, impl, shifted, radii, angles, distributions, max_radii);
+        });
+
+        return distributions;
+    }
+
+
+    /// Index of the lowest value of every row (lowest index if equal)
+    std::vector<unsigned int> lowest_indizes(const std::vector<double>& values, size_t row_size) {
+        std::vector<unsigned int> indizes(row_size == 0 ? 0 : values.size() / row_size);
+
+        for (size_t i = 0; i < indizes.size(); i++) {
+            auto first = values.begin() + i * row_size;
+            indizes[i] = static_cast<unsigned int>(std::distance(first, std::min_element(first, first + row_size)));
+        }
+
+        return indizes;
+    }
+
+
+    /// Whether the method splits the image (every part gets its own dominant angle)
+    bool splits_image(GLCM::Method meth) {
+        using namespace GLCM;
+
+        return meth == SPLIT_IMAGE_1x2 || meth == SPLIT_IMAGE_1x3 || meth == SPLIT_IMAGE_1x4
+            || meth == SPLIT_IMAGE_2x1 || meth == SPLIT_IMAGE_2x2 || meth == SPLIT_IMAGE_2x3 || meth == SPLIT_IMAGE_2x4
+            || meth == SPLIT_IMAGE_3x1 || meth == SPLIT_IMAGE_3x2 || meth == SPLIT_IMAGE_3x3 || meth == SPLIT_IMAGE_3x4
+            || meth == SPLIT_IMAGE_4x1 || meth == SPLIT_IMAGE_4x2 || meth == SPLIT_IMAGE_4x3 || meth == SPLIT_IMAGE_4x4;
+    }
+
+
+    /**
+     *  Returns the dominant angles of a distribution (every method but splitting the image)
+     *
+     *  @param orientation_dist     the distribution of the angles of the range
+     *  @param meth                 which method is used to get the angles
+     *  @param begin                first angle of the range (in degrees)
+     *  @return                     the dominant angle(s) (in degrees!)
+     */
+    // TODO: Noch nicht eingefügte Möglichkeiten bedenken!
+    std::vector<unsigned int> select_angles(const std::vector<double>& orientation_dist, GLCM::Method meth,
+                                             unsigned int begin) {
+        using namespace GLCM;
+        std::vector<unsigned int> angles;
+
+        switch (meth) {
+            case TOP_2:
+                angles = Util::getLowestIndizes(orientation_dist, 2);
+                break;
+            case TOP_3:
+                angles = Util::getLowestIndizes(orientation_dist, 3);
+                break;
+            default:
+                double value;
+
+                if (meth == MEDIAN) {
+                    value = Util::getMedianValue(orientation_dist);
+                } else if (meth == AVERAGE) {
+                    value = Util::getAverageValue(orientation_dist);
+                } else if (meth == L_QUARTILE) {
+                    value = Util::getQuantileValue(orientation_dist, LOWER_QUARTILE);
+                } else {
+                    throw std::runtime_error("[GLCM::main_angles] Other Methods not implemented yet!");
+                }
+
+                // REVIEW: No parallel region here, concurrent push_back is a data race (and 180 values are nothing)
+                for (auto it = orientation_dist.begin(); it < orientation_dist.end(); ++it) {
+                    if (*it >= value) continue;
+                    angles.push_back(begin + std::distance(orientation_dist.begin(), it));
+                }
+
+                return angles;
+        }
+
+        // TODO: Better parallelization -> see: https://stackoverflow.com/a/43169193
+        //#pragma omp declare reduction(vector_unsigned_int_plus : \
+        //                                std::vector<unsigned int> : std::transform( \
+        //                                    omp_out.begin(), omp_out.end(), omp_in.begin(), omp_out.begin(), \
+        //                                    std::plus<unsigned int>() \
+        //                                )) initializer(omp_priv = decltype(omp_orig)(omp_orig.size()))
+
+#ifndef WIN32
+        #pragma omp parallel for //reduction(vector_unsigned_int_plus: angles)
+#endif
+        for (int i = 0; i < angles.size(); i++) {
+            angles[i] += begin;
+        }
+
+        return angles;
+    }
+}
+
+
+
 /***********************************************************************************************************************
  *
  *      Functions calling other functions
@@ -18,21 +162,22 @@
  ***********************************************************************************************************************/
 
 /// Calculates the dominant texture orientation of an image (equals the "min_theta"-function from the paper).
-unsigned int GLCM::main_angle(const cv::Mat& image, Implementation impl, unsigned int max_r) {
-    return main_angle(image, impl, GLCM::Range(0, 179), max_r);
+unsigned int GLCM::main_angle(const cv::Mat& image, Implementation impl, unsigned int max_r, const Options& options) {
+    return main_angle(image, impl, GLCM::Range(0, 179), max_r, options);
 }
 
 
 /// Calculates the dominant texture orientations of the image (one or more + duplicates possible).
-std::vector<unsigned int> GLCM::main_angles(const cv::Mat& image, Implementation impl, Method meth, unsigned int max_r) {
-    return main_angles(image, impl, meth, GLCM::Range(0, 179), max_r);
+std::vector<unsigned int> GLCM::main_angles(const cv::Mat& image, Implementation impl, Method meth, unsigned int max_r,
+                                                const Options& options) {
+    return main_angles(image, impl, meth, GLCM::Range(0, 179), max_r, options);
 }
 
 
 /// Calculates the dominant texture orientations of the image (one or more possible).
 std::set<unsigned int> GLCM::main_angles_set(const cv::Mat &image, GLCM::Implementation impl, GLCM::Method meth,
-                                                unsigned int max_r) {
-    return main_angles_set(image, impl, meth, GLCM::Range(0, 179), max_r);
+                                                unsigned int max_r, const Options& options) {
+    return main_angles_set(image, impl, meth, GLCM::Range(0, 179), max_r, options);
 }
 
 
@@ -44,98 +189,320 @@ std::set<unsigned int> GLCM::main_angles_set(const cv::Mat &image, GLCM::Impleme
  ***********************************************************************************************************************/
 
 /// Calculates the one dominant texture orientation of an image for specific angles.
-unsigned int GLCM::main_angle(const cv::Mat& image, Implementation impl, const Range& range, unsigned int max_r) {
-    unsigned int max_radius = max_r != 0 ? max_r : ceil(sqrt(2)*std::max(image.cols/2, image.rows/2));
-    std::vector<double> orientation_distribution = getAngleDistribution(image, impl, max_radius, range);
-
-    return range.first + std::distance(
-            orientation_distribution.begin(),
-            min_element(orientation_distribution.begin(), orientation_distribution.end())
-    );
+unsigned int GLCM::main_angle(const cv::Mat& image, Implementation impl, const Range& range, unsigned int max_r,
+                                const Options& options) {
+    return search_angle(image, impl, max_radius_of(image.size(), max_r), range, options);
 }
 
 
 /// Calculates the dominant texture orientations of the image (one or more + duplicates possible) for specific angles.
-// TODO: Noch nicht eingefügte Möglichkeiten bedenken!
 std::vector<unsigned int> GLCM::main_angles(const cv::Mat& image, Implementation impl, Method meth, const Range& range,
-                                                unsigned int max_r) {
-    unsigned int max_radius = max_r != 0 ? max_r : ceil(sqrt(2)*std::max(image.cols/2, image.rows/2));
+                                                unsigned int max_r, const Options& options) {
+    unsigned int max_radius = max_radius_of(image.size(), max_r);
     std::vector<unsigned int> angles;
 
     // Test for image splitting method!
-    if (meth == SPLIT_IMAGE_1x2 || meth == SPLIT_IMAGE_1x3 || meth == SPLIT_IMAGE_1x4
-        || meth == SPLIT_IMAGE_2x1 || meth == SPLIT_IMAGE_2x2 || meth == SPLIT_IMAGE_2x3 || meth == SPLIT_IMAGE_2x4
-        || meth == SPLIT_IMAGE_3x1 || meth == SPLIT_IMAGE_3x2 || meth == SPLIT_IMAGE_3x3 || meth == SPLIT_IMAGE_3x4
-        || meth == SPLIT_IMAGE_4x1 || meth == SPLIT_IMAGE_4x2 || meth == SPLIT_IMAGE_4x3 || meth == SPLIT_IMAGE_4x4) {
-        Util::split_image(image, angles, impl, meth, range, max_radius);
+    if (splits_image(meth)) {
+        Util::split_image(image, angles, impl, meth, range, max_radius, options);
         return angles;
     }
 
-    std::vector<double> orientation_dist = getAngleDistribution(image, impl, max_radius, range);
-    auto begin = static_cast<unsigned int>(range.first);
-
-    switch (meth) {
-        case TOP_2:
-            angles = Util::getLowestIndizes(orientation_dist, 2);
-            break;
-        case TOP_3:
-            angles = Util::getLowestIndizes(orientation_dist, 3);
-            break;
-        default:
-            double value;
-
-            if (meth == MEDIAN) {
-                value = Util::getMedianValue(orientation_dist);
-            } else if (meth == AVERAGE) {
-                value = Util::getAverageValue(orientation_dist);
-            } else if (meth == L_QUARTILE) {
-                value = Util::getQuantileValue(orientation_dist, LOWER_QUARTILE);
-            } else {
-                throw std::runtime_error("[GLCM::main_angles] Other Methods not implemented yet!");
-            }
-
-            // TODO: Better parallelization -> see: https://stackoverflow.com/a/18671256
-            //#pragma omp declare reduction(vector_push_back : \
-            //                                std::vector<unsigned int> : \
-            //                                omp_out.insert(omp_out.end(), omp_in.begin(), omp_in.end()))
+    std::vector<double> orientation_dist = getAngleDistribution(image, impl, max_radius, range, options);
+
+    return select_angles(orientation_dist, meth, static_cast<unsigned int>(range.first));
+}
 
-#ifndef WIN32
-            #pragma omp parallel for //ordered //reduction(vector_push_back: angles)
-#endif
-            for (auto it = orientation_dist.begin(); it < orientation_dist.end(); ++it) {
-                if (*it >= value) continue;
-                angles.push_back(begin + std::distance(orientation_dist.begin(), it));
-            }
 
-            return angles;
+/// Calculates the dominant texture orientations of the image (one or more possible) for specific angles.
+std::set<unsigned int> GLCM::main_angles_set(const cv::Mat &image, GLCM::Implementation impl, GLCM::Method meth,
+                                                const GLCM::Range &range, unsigned int max_r, const Options& options) {
+    std::vector<unsigned int> angles = main_angles(image, impl, meth, range, max_r, options);
+    return std::set<unsigned int>(angles.begin(), angles.end());
+}
+
+
+/// Calculates the dominant texture orientation of every image of a batch.
+std::vector<unsigned int> GLCM::main_angle_batch(const std::vector<cv::Mat>& images, Implementation impl,
+                                                    const Range& range, unsigned int max_r,
+                                                    const std::vector<Options>& options) {
+    if (!options.empty() && options.size() != images.size()) {
+        throw std::invalid_argument("[GLCM::main_angle_batch] Options needed for every image (or none at all)!");
     }
 
-    // TODO: Better parallelization -> see: https://stackoverflow.com/a/43169193
-    //#pragma omp declare reduction(vector_unsigned_int_plus : \
-    //                                std::vector<unsigned int> : std::transform( \
-    //                                    omp_out.begin(), omp_out.end(), omp_in.begin(), omp_out.begin(), \
-    //                                    std::plus<unsigned int>() \
-    //                                )) initializer(omp_priv = decltype(omp_orig)(omp_orig.size()))
+    std::vector<unsigned int> angles(range.second - range.first + 1);
+    std::iota(angles.begin(), angles.end(), static_cast<unsigned int>(range.first));
 
-#ifndef WIN32
-    #pragma omp parallel for //reduction(vector_unsigned_int_plus: angles)
-#endif
-    for (int i = 0; i < angles.size(); i++) {
-        angles[i] += begin;
+    std::vector<unsigned int> result(images.size(), range.first);
+    std::vector<std::vector<double>> distributions(images.size());
+    std::vector<Batch::Job> jobs;
+    const Options defaults;
+
+    for (size_t i = 0; i < images.size(); i++) {
+        const Options& item_options = options.empty() ? defaults : options[i];
+        unsigned int max_radius = max_radius_of(images[i].size(), max_r);
+
+        if (item_options.search != FULL) {
+            // Every round / level depends on the previous one => the whole search is a single job
+            jobs.push_back(Batch::single_job(item_options, [&, i, max_radius](const Options& unit_options) {
+                result[i] = search_angle(images[i], impl, max_radius, range, unit_options);
+            }));
+
+            continue;
+        }
+
+        jobs.push_back(Batch::distribution_job(images[i], impl, max_radius, angles, item_options, distributions[i]));
+    }
+
+    Batch::run(jobs);
+
+    for (size_t i = 0; i < images.size(); i++) {
+        // Searched coarse-to-fine / using the pyramid => already done
+        if (distributions[i].empty()) continue;
+
+        result[i] = range.first + std::distance(
+                distributions[i].begin(),
+                min_element(distributions[i].begin(), distributions[i].end())
+        );
     }
 
-    return angles;
+    return result;
 }
 
 
-/// Calculates the dominant texture orientations of the image (one or more possible) for specific angles.
-std::set<unsigned int> GLCM::main_angles_set(const cv::Mat &image, GLCM::Implementation impl, GLCM::Method meth,
-                                                const GLCM::Range &range, unsigned int max_r) {
-    std::vector<unsigned int> angles = main_angles(image, impl, meth, range, max_r);
-    return std::set<unsigned int>(angles.begin(), angles.end());
+/// Calculates the dominant texture orientations of every image of a batch (one or more + duplicates possible).
+std::vector<std::vector<unsigned int>> GLCM::main_angles_batch(const std::vector<cv::Mat>& images, Implementation impl,
+                                                                Method meth, const Range& range, unsigned int max_r,
+                                                                const std::vector<Options>& options) {
+    if (!options.empty() && options.size() != images.size()) {
+        throw std::invalid_argument("[GLCM::main_angles_batch] Options needed for every image (or none at all)!");
+    }
+
+    std::vector<unsigned int> angles(range.second - range.first + 1);
+    std::iota(angles.begin(), angles.end(), static_cast<unsigned int>(range.first));
+
+    std::vector<std::vector<unsigned int>> result(images.size());
+    std::vector<std::vector<double>> distributions(images.size());
+    std::vector<Batch::Job> jobs;
+    const Options defaults;
+
+    for (size_t i = 0; i < images.size(); i++) {
+        const Options& item_options = options.empty() ? defaults : options[i];
+        unsigned int max_radius = max_radius_of(images[i].size(), max_r);
+
+        if (splits_image(meth)) {
+            // Every part of the image is a calculation of its own => the whole image is a single job
+            jobs.push_back(Batch::single_job(item_options, [&, i, max_radius](const Options& unit_options) {
+                Util::split_image(images[i], result[i], impl, meth, range, max_radius, unit_options);
+            }));
+
+            continue;
+        }
+
+        jobs.push_back(Batch::distribution_job(images[i], impl, max_radius, angles, item_options, distributions[i]));
+    }
+
+    Batch::run(jobs);
+
+    if (splits_image(meth)) return result;
+
+    for (size_t i = 0; i < images.size(); i++) {
+        result[i] = select_angles(distributions[i], meth, static_cast<unsigned int>(range.first));
+    }
+
+    return result;
+}
+
+
+
+/// Calculates the dominant texture orientation of every window sliding over the image (one angle per window).
+cv::Mat GLCM::orientation_map(const cv::Mat& image, Implementation impl, const cv::Size& window, const cv::Size& stride,
+                                const Range& range, unsigned int max_r, const Options& options) {
+    cv::Mat strength;
+    return orientation_map(image, strength, impl, window, stride, range, max_r, options);
+}
+
+
+/// Calculates the dominant texture orientation and its strength of every window sliding over the image.
+cv::Mat GLCM::orientation_map(const cv::Mat& image, cv::Mat& strength, Implementation impl, const cv::Size& window,
+                                const cv::Size& stride, const Range& range, unsigned int max_r,
+                                const Options& options) {
+    if (window.width <= 0 || window.height <= 0 || window.width > image.cols || window.height > image.rows) {
+        throw std::invalid_argument("[GLCM::orientation_map] Window has to be positive and fit inside the image!");
+    }
+
+    if (stride.width <= 0 || stride.height <= 0) {
+        throw std::invalid_argument("[GLCM::orientation_map] Stride has to be positive!");
+    }
+
+    int map_rows = (image.rows - window.height) / stride.height + 1;
+    int map_cols = (image.cols - window.width) / stride.width + 1;
+
+    std::vector<cv::Rect> windows;
+    windows.reserve(static_cast<size_t>(map_rows) * map_cols);
+
+    for (int y = 0; y < map_rows; y++) {
+        for (int x = 0; x < map_cols; x++) {
+            windows.emplace_back(x * stride.width, y * stride.height, window.width, window.height);
+        }
+    }
+
+    std::vector<unsigned int> angles(range.second - range.first + 1);
+    std::iota(angles.begin(), angles.end(), static_cast<unsigned int>(range.first));
+
+    std::vector<unsigned int> radii = radius_schedule(max_radius_of(window, max_r), options);
+    std::vector<double> distributions = window_distributions(image, impl, windows, angles, radii, {}, options);
+    std::vector<unsigned int> lowest = lowest_indizes(distributions, angles.size());
+
+    cv::Mat1i result(map_rows, map_cols);
+    cv::Mat1d strengths(map_rows, map_cols);
+
+    for (size_t w = 0; w < windows.size(); w++) {
+        auto first = distributions.begin() + w * angles.size();
+        double mean = std::accumulate(first, first + angles.size(), 0.0) / angles.size();
+        int y = static_cast<int>(w) / map_cols, x = static_cast<int>(w) % map_cols;
+
+        result(y, x) = range.first + lowest[w];
+        strengths(y, x) = mean > 0 ? 1.0 - first[lowest[w]] / mean : 0.0;
+    }
+
+    if (options.statistics != nullptr) {
+        options.statistics->angles += angles.size() * windows.size();
+        options.statistics->radii += radii.size() * windows.size();
+    }
+
+    strength = strengths;
+    return result;
+}
+
+
+/// Calculates the dominant texture orientation of every region of interest of the image (one angle per region).
+std::vector<unsigned int> GLCM::main_angle_rois(const cv::Mat& image, const std::vector<cv::Rect>& rois,
+                                                    Implementation impl, const Range& range, unsigned int max_r,
+                                                    const Options& options) {
+    for (const cv::Rect& roi : rois) {
+        if (roi.width <= 0 || roi.height <= 0 || (roi & cv::Rect(0, 0, image.cols, image.rows)) != roi) {
+            throw std::invalid_argument("[GLCM::main_angle_rois] Regions have to be non-empty and inside the image!");
+        }
+    }
+
+    if (options.engine == AUTOCORRELATION && impl != STANDARD) {
+        throw std::invalid_argument("[GLCM::main_angle_rois] AUTOCORRELATION only supports STANDARD implementation!");
+    }
+
+    std::vector<unsigned int> result;
+
+    if (impl == SCHEME1 || options.search != FULL || options.stable_radii != 0) {
+        // Depends on the region itself => every region gets calculated on its own
+        for (const cv::Rect& roi : rois) result.push_back(main_angle(image(roi), impl, range, max_r, options));
+        return result;
+    }
+
+    std::vector<unsigned int> angles(range.second - range.first + 1);
+    std::iota(angles.begin(), angles.end(), static_cast<unsigned int>(range.first));
+
+    // Every region uses the radii of the schedule up to its own maximum radius (explicit radii: all of them)
+    std::vector<unsigned int> max_radii;
+    for (const cv::Rect& roi : rois) max_radii.push_back(max_radius_of(roi.size(), max_r));
+    if (options.schedule == EXPLICIT) max_radii.clear();
+
+    unsigned int max_radius = max_radii.empty() ? 0 : *std::max_element(max_radii.begin(), max_radii.end());
+    std::vector<unsigned int> radii = radius_schedule(max_radius, options);
+
+    std::vector<double> distributions = window_distributions(image, impl, rois, angles, radii, max_radii, options);
+
+    for (unsigned int lowest : lowest_indizes(distributions, angles.size())) result.push_back(range.first + lowest);
+
+    if (options.statistics != nullptr) {
+        for (size_t i = 0; i < rois.size(); i++) {
+            options.statistics->angles += angles.size();
+            options.statistics->radii += max_radii.empty() ? radii.size() : std::count_if(
+                    radii.begin(), radii.end(), [&](unsigned int r) { return r <= max_radii[i]; });
+        }
+    }
+
+    return result;
+}
+
+
+/// Calculates the dominant texture orientation of every sub-image of a grid (every pixel belongs to exactly one).
+std::vector<unsigned int> GLCM::main_angle_grid(const cv::Mat& image, Implementation impl, const cv::Size& grid,
+                                                    const Range& range, unsigned int max_r, const Options& options) {
+    return main_angle_rois(image, Util::grid(image.size(), grid), impl, range, max_r, options);
 }
 
 
+/// Calculates Haralick statistics of every (angle, radius) pair together with the distribution of the angles.
+GLCM::TextureFeatureMap GLCM::texture_features(const cv::Mat& image, Implementation impl, int features,
+                                               const Range& range, unsigned int max_r, const Options& options) {
+    if (range.first > range.second || range.second > 179) {
+        throw std::invalid_argument("[GLCM::texture_features] Range has to be inside of 0 ... 179!");
+    }
+
+    TextureFeatureMap map;
+    map.angles.resize(range.second - range.first + 1);
+    std::iota(map.angles.begin(), map.angles.end(), static_cast<unsigned int>(range.first));
+
+    // Every statistic needs the GLCM itself => prepared and stored (dense or sparse) as used by the MATRIX engine
+    Options matrix = options;
+    matrix.engine = MATRIX;
+
+    int max_gray = 0;
+    cv::Mat gray = prepare_image(image, matrix, max_gray);
+    map.radii = radius_schedule(max_radius_of(gray.size(), max_r), options);
+
+    std::vector<double> z;
+    with_image_type(gray, [&](const auto& typed) {
+        with_storage(typed, matrix, max_gray, [&](auto storage) {
+            typedef typename decltype(storage)::type G;
+            Features::calc_features<G>(typed, impl, map.radii, map.angles, features, max_gray, map.features, z);
+        });
+    });
+
+    // Exact sums (see GLCM::exact_sum) => same distribution as GLCM::calc_angle_dist
+    size_t n_radii = map.radii.size();
+    map.distribution.assign(map.angles.size(), 0.0);
+
+    for (size_t theta = 0; theta < map.angles.size(); theta++) {
+        auto first = z.begin() + theta * n_radii;
+        map.distribution[theta] = exact_sum(first, first + n_radii);
+    }
+
+    if (options.statistics != nullptr) {
+        options.statistics->angles += map.angles.size();
+        options.statistics->radii += n_radii;
+    }
+
+    return map;
+}
+
+
+/// Aggregates the features of every angle (mean of all its radii).
+std::vector<GLCM::TextureFeatures> GLCM::features_per_angle(const TextureFeatureMap& map) {
+    std::vector<TextureFeatures> result(map.angles.size());
+    size_t n_radii = map.radii.size();
+
+    if (map.features.size() != map.angles.size() * n_radii) {
+        throw std::invalid_argument("[GLCM::features_per_angle] Features do not fit the angles and radii!");
+    }
+
+    if (n_radii == 0) return result;
+
+    for (size_t theta = 0; theta < map.angles.size(); theta++) {
+        TextureFeatures& mean = result[theta];
+
+        for (size_t r = 0; r < n_radii; r++) {
+            const TextureFeatures& pair = map.features[theta * n_radii + r];
+            mean.contrast += pair.contrast / n_radii;
+            mean.energy += pair.energy / n_radii;
+            mean.entropy += pair.entropy / n_radii;
+            mean.homogeneity += pair.homogeneity / n_radii;
+            mean.correlation += pair.correlation / n_radii;
+        }
+    }
+
+    return result;
+}
+
 
 #ifdef AIOLOS_FEATURE_MORE_TYPE_SUPPORT
 /***********************************************************************************************************************
@@ -145,22 +512,23 @@ std::set<unsigned int> GLCM::main_angles_set(const cv::Mat &image, GLCM::Impleme
  ***********************************************************************************************************************/
 
 /// Calculates the one dominant texture orientation of an image for specific angles.
-unsigned int GLCM::main_angle(const cv::Mat& image, GLCM::Implementation impl, const cv::Range& range, unsigned int max_r) {
-    return main_angle(image, impl, GLCM::Range(range.start, range.end), max_r);
+unsigned int GLCM::main_angle(const cv::Mat& image, GLCM::Implementation impl, const cv::Range& range, unsigned int max_r,
+                                const Options& options) {
+    return main_angle(image, impl, GLCM::Range(range.start, range.end), max_r, options);
 }
 
 
 /// Calculates the dominant texture orientations of the image (one or more + duplicates possible) for specific angles.
 std::vector<unsigned int> GLCM::main_angles(const cv::Mat& image, GLCM::Implementation impl, GLCM::Method meth,
-                                                const cv::Range& range, unsigned int max_r) {
-    return main_angles(image, impl, meth, GLCM::Range(range.start, range.end), max_r);
+                                                const cv::Range& range, unsigned int max_r, const Options& options) {
+    return main_angles(image, impl, meth, GLCM::Range(range.start, range.end), max_r, options);
 }
 
 
 /// Calculates the dominant texture orientations of the image (one or more possible) for specific angles.
 std::set<unsigned int> GLCM::main_angles_set(const cv::Mat& image, GLCM::Implementation impl, GLCM::Method meth,
-                                                const cv::Range& range, unsigned int max_r) {
-    return main_angles_set(image, impl, meth, GLCM::Range(range.start, range.end), max_r);
+                                                const cv::Range& range, unsigned int max_r, const Options& options) {
+    return main_angles_set(image, impl, meth, GLCM::Range(range.start, range.end), max_r, options);
 }
 #endif
 
@@ -174,66 +542,71 @@ std::set<unsigned int> GLCM::main_angles_set(const cv::Mat& image, GLCM::Impleme
  ***********************************************************************************************************************/
 
 /// Calculates the dominant texture orientation of a sub-image (equals the "min_theta"-function from the paper).
-unsigned int GLCM::main_angle(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl, unsigned int max_r) {
-    return main_angle(image(boundaries), impl, max_r);
+unsigned int GLCM::main_angle(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl, unsigned int max_r,
+                                const Options& options) {
+    return main_angle(image(boundaries), impl, max_r, options);
 }
 
 
 /// Calculates the one dominant texture orientation of a sub-image for specific angles.
 unsigned int GLCM::main_angle(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                const GLCM::Range& range, unsigned int max_r) {
-    return main_angle(image(boundaries), impl, range, max_r);
+                                const GLCM::Range& range, unsigned int max_r, const Options& options) {
+    return main_angle(image(boundaries), impl, range, max_r, options);
 }
 
 
 
 /// Calculates the dominant texture orientations of the sub-image (one or more + duplicates possible).
 std::vector<unsigned int> GLCM::main_angles(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                                GLCM::Method meth, unsigned int max_r) {
-    return main_angles(image(boundaries), impl, meth, max_r);
+                                                GLCM::Method meth, unsigned int max_r, const Options& options) {
+    return main_angles(image(boundaries), impl, meth, max_r, options);
 }
 
 
 /// Calculates the dominant texture orientations of the sub-image (one or more + duplicates possible) for specific angles.
 std::vector<unsigned int> GLCM::main_angles(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                                GLCM::Method meth, const GLCM::Range& range, unsigned int max_r) {
-    return main_angles(image(boundaries), impl, meth, range, max_r);
+                                                GLCM::Method meth, const GLCM::Range& range, unsigned int max_r,
+                                                const Options& options) {
+    return main_angles(image(boundaries), impl, meth, range, max_r, options);
 }
 
 
 /// Calculates the dominant texture orientations of the sub-image (one or more possible).
 std::set<unsigned int> GLCM::main_angles_set(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                                GLCM::Method meth, unsigned int max_r) {
-    return main_angles_set(image(boundaries), impl, meth, max_r);
+                                                GLCM::Method meth, unsigned int max_r, const Options& options) {
+    return main_angles_set(image(boundaries), impl, meth, max_r, options);
 }
 
 
 /// Calculates the dominant texture orientations of the sub-image (one or more possible) for specific angles.
 std::set<unsigned int> GLCM::main_angles_set(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                                GLCM::Method meth, const GLCM::Range& range, unsigned int max_r) {
-    return main_angles_set(image(boundaries), impl, meth, range, max_r);
+                                                GLCM::Method meth, const GLCM::Range& range, unsigned int max_r,
+                                                const Options& options) {
+    return main_angles_set(image(boundaries), impl, meth, range, max_r, options);
 }
 
 
 #ifdef AIOLOS_FEATURE_MORE_TYPE_SUPPORT
 /// Calculates the one dominant texture orientation of a sub-image for specific angles.
 unsigned int GLCM::main_angle(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                const cv::Range& range, unsigned int max_r) {
-    return main_angle(image(boundaries), impl, GLCM::Range(range.start, range.end), max_r);
+                                const cv::Range& range, unsigned int max_r, const Options& options) {
+    return main_angle(image(boundaries), impl, GLCM::Range(range.start, range.end), max_r, options);
 }
 
 
 /// Calculates the dominant texture orientations of the sub-image (one or more + duplicates possible) for specific angles.
 std::vector<unsigned int> GLCM::main_angles(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                                GLCM::Method meth, const cv::Range& range, unsigned int max_r) {
-    return main_angles(image(boundaries), impl, meth, GLCM::Range(range.start, range.end), max_r);
+                                                GLCM::Method meth, const cv::Range& range, unsigned int max_r,
+                                                const Options& options) {
+    return main_angles(image(boundaries), impl, meth, GLCM::Range(range.start, range.end), max_r, options);
 }
 
 
 /// Calculates the dominant texture orientations of the sub-image (one or more possible) for specific angles.
 std::set<unsigned int> GLCM::main_angles_set(const cv::Mat& image, const cv::Rect& boundaries, GLCM::Implementation impl,
-                                                GLCM::Method meth, const cv::Range& range, unsigned int max_r) {
-    return main_angles_set(image(boundaries), impl, meth, GLCM::Range(range.start, range.end), max_r);
+                                                GLCM::Method meth, const cv::Range& range, unsigned int max_r,
+                                                const Options& options) {
+    return main_angles_set(image(boundaries), impl, meth, GLCM::Range(range.start, range.end), max_r, options);
 }
 #endif
 #endif
@@ -0,0 +1,160 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#include <vector>
+#include <cstring>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+#include "util/MatrixFunctions.h"
+#include "impl/Distribution.h"
+#include "Incremental.h"
+
+
+/***********************************************************************************************************************
+ *
+ *      Private helper functions
+ *
+ ***********************************************************************************************************************/
+
+namespace {
+    /**
+     *  Marks every row of the frame differing from the previous one
+     *
+     *  @param current      the current frame (prepared)
+     *  @param previous     the previous frame (prepared, same size and type) or empty => every row changed
+     *  @return             number of changed rows before every row (rows + 1 entries, prefix sums)
+     */
+    std::vector<int> changed_rows(const cv::Mat& current, const cv::Mat& previous) {
+        std::vector<int> changed(current.rows + 1, 0);
+        size_t bytes = current.cols * current.elemSize();
+
+        for (int y = 0; y < current.rows; y++) {
+            bool differs = previous.empty() || std::memcmp(current.ptr(y), previous.ptr(y), bytes) != 0;
+            changed[y + 1] = changed[y] + (differs ? 1 : 0);
+        }
+
+        return changed;
+    }
+
+
+    /// Whether any row of [begin, end) changed (clipped to the frame)
+    bool any_changed(const std::vector<int>& changed, int begin, int end) {
+        int rows = static_cast<int>(changed.size()) - 1;
+        begin = std::max(begin, 0);
+        end = std::min(end, rows);
+
+        return begin < end && changed[end] != changed[begin];
+    }
+}
+
+
+
+/***********************************************************************************************************************
+ *
+ *      Actual implementation of the functions
+ *
+ ***********************************************************************************************************************/
+
+GLCM::IncrementalEstimator::IncrementalEstimator(Implementation impl, const Range& range, unsigned int max_r,
+                                                 const Options& options, int band_height)
+        : impl(impl), range(range), max_r(max_r), options(options), band_height(band_height) {
+    if (impl == SCHEME1) {
+        throw std::invalid_argument("[GLCM::IncrementalEstimator] SCHEME1 rotates the whole frame, no bands possible!");
+    }
+
+    if (options.stable_radii != 0) {
+        throw std::invalid_argument("[GLCM::IncrementalEstimator] Stable radii depend on the whole distribution!");
+    }
+
+    if (band_height <= 0) throw std::invalid_argument("[GLCM::IncrementalEstimator] Band height has to be positive!");
+
+    angles.resize(range.second - range.first + 1);
+    std::iota(angles.begin(), angles.end(), static_cast<unsigned int>(range.first));
+}
+
+
+/// Forgets the previous frame.
+void GLCM::IncrementalEstimator::reset() {
+    previous.release();
+    partial.clear();
+    values.clear();
+    last_recalculated = 0;
+}
+
+
+/// Calculates the bands of every (angle, radius) pair containing a changed pixel or partner, sums up every band.
+unsigned int GLCM::IncrementalEstimator::update(const cv::Mat& image) {
+    int max_gray = 0;
+    cv::Mat gray = prepare_image(image, options, max_gray);
+
+    // Another size / type => nothing to compare with
+    if (!previous.empty() && (previous.size() != gray.size() || previous.type() != gray.type())) reset();
+
+    int n_bands = (gray.rows + band_height - 1) / band_height;
+
+    if (previous.empty()) {
+        radii = radius_schedule(max_radius_of(gray.size(), max_r), options);
+        partial.assign(angles.size() * radii.size() * n_bands, 0);
+    }
+
+    std::vector<int> changed = changed_rows(gray, previous);
+    std::shared_ptr<const OffsetTable> offsets = offset_table(angles, radii);
+
+    // Interpolating implementations need the row below the partner as well
+    int extent = impl == STANDARD ? 0 : 1;
+
+    // Work item := (angle, radius, band) whose pixels or partners (halo) lie in a changed row
+    std::vector<long> items;
+    for (size_t pair = 0; pair < offsets->size(); pair++) {
+        int dist_y = (*offsets)[pair].dist_y;
+
+        for (int band = 0; band < n_bands; band++) {
+            int begin = band * band_height, end = std::min(begin + band_height, gray.rows);
+
+            if (any_changed(changed, begin, end) || any_changed(changed, begin + dist_y, end + dist_y + extent)) {
+                items.push_back(static_cast<long>(pair) * n_bands + band);
+            }
+        }
+    }
+
+    with_image_type(gray, [&](const auto& typed) {
+        typedef typename std::decay<decltype(typed)>::type::value_type T;
+        long n_items = static_cast<long>(items.size());
+
+        #pragma omp parallel for schedule(dynamic)
+        for (long i = 0; i < n_items; i++) {
+            long pair = items[i] / n_bands;
+            int begin = static_cast<int>(items[i] % n_bands) * band_height;
+
+            // DIFFERENCE => same value as every other engine, without creating a GLCM per band
+            partial[items[i]] = static_cast<std::uint64_t>(calc_concentration_degree<cv::Mat_<int>, T>(
+                    typed, impl, DIFFERENCE, max_gray, (*offsets)[pair],
+                    cv::Range(begin, std::min(begin + band_height, typed.rows))));
+        }
+    });
+
+    // Integers only (summed up as std::uint64_t) => same sum as the whole frame, independent of the order
+    long n_radii = static_cast<long>(radii.size());
+    values.assign(angles.size(), 0.0);
+
+    for (size_t theta = 0; theta < angles.size(); theta++) {
+        const std::uint64_t* first = partial.data() + theta * n_radii * n_bands;
+        values[theta] = static_cast<double>(std::accumulate(first, first + n_radii * n_bands, std::uint64_t(0)));
+    }
+
+    if (options.statistics != nullptr) {
+        options.statistics->angles += angles.size();
+        options.statistics->radii += radii.size();
+    }
+
+    last_recalculated = partial.empty() ? 0.0 : static_cast<double>(items.size()) / partial.size();
+
+    // Prepared frame may share the data of the given one (reused by the caller for the next frame)
+    previous = gray.data == image.data ? gray.clone() : gray;
+
+    return range.first + std::distance(values.begin(), std::min_element(values.begin(), values.end()));
+}
@@ -0,0 +1,219 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "util/MatrixFunctions.h"
+#include "impl/Distribution.h"
+#include "Tracker.h"
+
+
+/***********************************************************************************************************************
+ *
+ *      Private helper functions
+ *
+ ***********************************************************************************************************************/
+
+namespace {
+    /// Values of the angles of a single frame, every angle gets calculated at most once
+    class Window {
+    public:
+        /**
+         *  @param range        interval of angles to consider
+         *  @param center       the angle the window starts around (inside of the range)
+         */
+        Window(const GLCM::Range& range, unsigned int center)
+                : first(range.first), size(range.second - range.first + 1), center(static_cast<int>(center)),
+                  circular(range.first == 0 && range.second == 179), values(size, 0.0), evaluated(size, false) {}
+
+
+        /// Lowest / highest offset to the center the window may be widened to (circular: at most 180 angles)
+        int lowest() const { return circular ? high - 179 : first - center; }
+        int highest() const { return circular ? low + 179 : first + size - 1 - center; }
+
+
+        /// Angle of the given offset to the center
+        unsigned int angle(int offset) const {
+            int a = center + offset;
+            return static_cast<unsigned int>(circular ? (a % 180 + 180) % 180 : a);
+        }
+
+
+        /**
+         *  Calculates every angle of the window not calculated yet
+         *
+         *  @param function     calculates the values of the given angles (same order)
+         */
+        template <typename F>
+        void evaluate(F function) {
+            std::vector<unsigned int> angles;
+            for (int d = low; d <= high; d++) {
+                if (!evaluated[angle(d) - first]) angles.push_back(angle(d));
+            }
+
+            if (angles.empty()) return;
+
+            std::vector<double> calculated = function(angles);
+            for (size_t i = 0; i < angles.size(); i++) {
+                values[angles[i] - first] = calculated[i];
+                evaluated[angles[i] - first] = true;
+            }
+        }
+
+
+        /// Offset of the minimum inside of the window (the lowest angle if there are several)
+        int minimum() const {
+            int best = low;
+            for (int d = low + 1; d <= high; d++) {
+                double current = value(d), best_value = value(best);
+                if (current < best_value || (current == best_value && angle(d) < angle(best))) best = d;
+            }
+
+            return best;
+        }
+
+
+        /// 1 - min / mean of every angle calculated within ±window around the given offset
+        double confidence(int offset, int window) const {
+            // Circular: every angle counted once at most
+            if (circular) window = std::min(window, 89);
+
+            double sum = 0;
+            unsigned int count = 0;
+
+            for (int d = offset - window; d <= offset + window; d++) {
+                if (!circular && (d < first - center || d > first + size - 1 - center)) continue;
+                if (!evaluated[angle(d) - first]) continue;
+
+                sum += value(d);
+                count++;
+            }
+
+            double mean = sum / count;
+            return mean > 0 ? 1 - value(offset) / mean : 0;
+        }
+
+
+        int first, size, center;
+        bool circular;
+        int low = 0, high = 0;                  // offsets of the window to the center
+
+        /// Value of the given offset to the center (calculated already)
+        double value(int offset) const { return values[angle(offset) - first]; }
+
+    private:
+        std::vector<double> values;
+        std::vector<bool> evaluated;
+    };
+}
+
+
+
+/***********************************************************************************************************************
+ *
+ *      Actual implementation of the functions
+ *
+ ***********************************************************************************************************************/
+
+GLCM::Tracker::Tracker(Implementation impl, const Range& range, unsigned int max_r, const Options& options,
+                       const TrackerOptions& tracking)
+        : impl(impl), range(range), max_r(max_r), options(options), tracking(tracking) {
+    if (range.first > range.second || range.second > 179) {
+        throw std::invalid_argument("[GLCM::Tracker] Range has to be inside of 0 ... 179!");
+    }
+
+    if (tracking.window == 0) throw std::invalid_argument("[GLCM::Tracker] Window has to be positive!");
+
+    if (tracking.confidence_drop < 0 || tracking.confidence_drop > 1) {
+        throw std::invalid_argument("[GLCM::Tracker] Confidence drop has to be inside of 0 ... 1!");
+    }
+}
+
+
+/// Forgets the previous frame.
+void GLCM::Tracker::reset() {
+    tracked = false;
+    frames = 0;
+    last_confidence = 0;
+    searched_fully = false;
+}
+
+
+/// Calculates the dominant angle of the next frame.
+unsigned int GLCM::Tracker::update(const cv::Mat& image) {
+    int max_gray = 0;
+    cv::Mat gray = prepare_image(image, options, max_gray);
+
+    return update_prepared(gray, max_gray);
+}
+
+
+/// Searches ±window around the previous angle, widened / replaced by a full search if necessary.
+unsigned int GLCM::Tracker::update_prepared(const cv::Mat& gray, int max_gray) {
+    unsigned int max_radius = max_radius_of(gray.size(), max_r);
+    int k = static_cast<int>(tracking.window);
+
+    auto calculate = [&](const std::vector<unsigned int>& angles) {
+        return getAngleDistribution(gray, impl, max_radius, angles, options, max_gray);
+    };
+
+    Window window(range, tracked ? angle : range.first);
+
+    // The whole range <=> offsets from the lowest to the highest angle of the range
+    auto search_fully = [&]() {
+        window.low = window.first - window.center;
+        window.high = window.low + window.size - 1;
+        window.evaluate(calculate);
+        searched_fully = true;
+    };
+
+    searched_fully = false;
+
+    if (!tracked || (tracking.full_search != 0 && frames >= tracking.full_search)) {
+        search_fully();
+    } else {
+        window.low = std::max(-k, window.lowest());
+        window.high = std::min(k, window.highest());
+
+        for (;;) {
+            if (window.high - window.low + 1 >= window.size) {
+                search_fully();
+                break;
+            }
+
+            window.evaluate(calculate);
+            double minimum = window.value(window.minimum());
+
+            // Minimum on an edge of the window (not of the range) => the angle may lie outside, widened to that side
+            // REVIEW: Checked by value, not by position => a plateau (Standard: same offsets for nearby angles)
+            //         reaching the edge widens the window as well
+            bool widen_low = window.value(window.low) == minimum && window.low > window.lowest();
+            bool widen_high = window.value(window.high) == minimum && window.high < window.highest();
+
+            if (!widen_low && !widen_high) break;
+
+            if (widen_low) window.low = std::max(window.low - k, window.lowest());
+            if (widen_high) window.high = std::min(window.high + k, window.highest());
+        }
+    }
+
+    int best = window.minimum();
+    double confidence = window.confidence(best, k);
+
+    if (!searched_fully && confidence < tracking.confidence_drop * last_confidence) {
+        search_fully();
+        best = window.minimum();
+        confidence = window.confidence(best, k);
+    }
+
+    angle = window.angle(best);
+    last_confidence = confidence;
+    tracked = true;
+    frames = searched_fully ? 1 : frames + 1;
+
+    return angle;
+}
@@ -0,0 +1,226 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <stdexcept>
+
+#include "util/MatrixFunctions.h"
+#include "impl/Distribution.h"
+#include "impl/Search.h"
+#include "impl/Queue.h"
+#include "Video.h"
+
+
+/***********************************************************************************************************************
+ *
+ *      Private helper functions
+ *
+ ***********************************************************************************************************************/
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+
+    /// Frame passed from one stage of the pipeline to the next one
+    struct Frame {
+        unsigned long index = 0;
+        cv::Mat image;
+        int max_gray = 0;                   // number of gray levels once prepared
+        Clock::time_point begin;            // when decoding the frame started
+        double decode = 0;
+        double preprocess = 0;
+    };
+
+
+    /// Milliseconds elapsed since the given point in time
+    double elapsed(const Clock::time_point& begin) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    }
+
+
+    /**
+     *  Waits for the next frame of the previous stage
+     *
+     *  @param queue        the queue of the previous stage
+     *  @param done         set by the previous stage after pushing its last frame
+     *  @param stop         set once any stage failed
+     *  @param frame        the returned frame
+     *  @return             whether a frame got returned (false if there are no more frames)
+     */
+    bool next(GLCM::SPSCQueue<Frame>& queue, const std::atomic<bool>& done, const std::atomic<bool>& stop,
+              Frame& frame) {
+        for (;;) {
+            if (queue.try_pop(frame)) return true;
+            if (done.load(std::memory_order_acquire)) return queue.try_pop(frame);
+            if (stop.load(std::memory_order_relaxed)) return false;
+
+            // Blocks (after spinning briefly) => the waiting stage leaves its core to the OpenMP threads
+            queue.wait([&]() {
+                return !queue.empty() || done.load(std::memory_order_acquire) || stop.load(std::memory_order_relaxed);
+            });
+        }
+    }
+}
+
+
+
+/***********************************************************************************************************************
+ *
+ *      Actual implementation of the functions
+ *
+ ***********************************************************************************************************************/
+
+GLCM::VideoProcessor::VideoProcessor(Implementation impl, const Range& range, unsigned int max_r,
+                                     const Options& options, size_t queue_size)
+        : impl(impl), range(range), max_r(max_r), options(options), queue_size(queue_size) {
+    if (queue_size == 0) throw std::invalid_argument("[GLCM::VideoProcessor] Queue size has to be positive!");
+}
+
+
+/// Processes every following video using a tracker.
+void GLCM::VideoProcessor::enable_tracking(const TrackerOptions& tracking) {
+    // Validates the settings right away (instead of once the first video gets processed)
+    Tracker(impl, range, max_r, options, tracking);
+
+    this->tracked = true;
+    this->tracking = tracking;
+}
+
+
+/// Processes every frame of an opened video.
+GLCM::VideoStatistics GLCM::VideoProcessor::process(cv::VideoCapture& capture, const Callback& callback) {
+    if (!capture.isOpened()) throw std::runtime_error("[GLCM::VideoProcessor::process] Video is not opened!");
+
+    return process([&capture](cv::Mat& frame) { return capture.read(frame); }, callback);
+}
+
+
+/// Processes every frame returned by the source: decoding -> converting to gray + quantizing -> calculation.
+GLCM::VideoStatistics GLCM::VideoProcessor::process(const Source& source, const Callback& callback) {
+    SPSCQueue<Frame> decoded(queue_size), prepared(queue_size);
+    std::atomic<bool> decoding_done{false}, preprocessing_done{false}, stop{false};
+
+    // Every thread stores its own exception => no synchronization needed besides joining
+    std::exception_ptr decoding_error, preprocessing_error;
+
+    // Wakes up every stage blocked on a queue (they wait for the queue, done or stop)
+    auto cancel = [&]() {
+        stop = true;
+        decoded.notify();
+        prepared.notify();
+    };
+
+    std::thread decoding([&]() {
+        try {
+            for (unsigned long index = 0;; index++) {
+                Frame frame;
+                frame.index = index;
+                frame.begin = Clock::now();
+
+                if (!source(frame.image) || frame.image.empty()) break;
+                frame.decode = elapsed(frame.begin);
+
+                if (!decoded.push(frame, stop)) break;
+            }
+        } catch (...) {
+            decoding_error = std::current_exception();
+            cancel();
+        }
+
+        decoding_done.store(true, std::memory_order_release);
+        decoded.notify();
+    });
+
+    std::thread preprocessing([&]() {
+        try {
+            Frame frame;
+            while (next(decoded, decoding_done, stop, frame)) {
+                auto begin = Clock::now();
+
+                cv::Mat gray = frame.image;
+                if (gray.channels() == 3) {
+                    cv::cvtColor(gray, gray, cv::COLOR_BGR2GRAY);
+                } else if (gray.channels() == 4) {
+                    cv::cvtColor(gray, gray, cv::COLOR_BGRA2GRAY);
+                }
+
+                // Quantized / compacted here => the calculation only works on prepared frames
+                frame.image = prepare_image(gray, options, frame.max_gray);
+                frame.preprocess = elapsed(begin);
+
+                if (!prepared.push(frame, stop)) break;
+            }
+        } catch (...) {
+            preprocessing_error = std::current_exception();
+            cancel();
+        }
+
+        preprocessing_done.store(true, std::memory_order_release);
+        prepared.notify();
+    });
+
+    VideoStatistics statistics;
+    std::unique_ptr<Tracker> tracker;
+    if (tracked) tracker = std::make_unique<Tracker>(impl, range, max_r, options, tracking);
+    auto begin = Clock::now();
+
+    try {
+        Frame frame;
+        while (next(prepared, preprocessing_done, stop, frame)) {
+            auto estimation = Clock::now();
+
+            FrameResult result;
+            result.index = frame.index;
+
+            unsigned int max_radius = max_radius_of(frame.image.size(), max_r);
+
+            if (tracker) {
+                result.angle = tracker->update_prepared(frame.image, frame.max_gray);
+                result.full_search = tracker->full_search();
+            } else {
+                result.angle = search_angle(frame.image, impl, max_radius, range, options, frame.max_gray);
+            }
+
+            result.decode = frame.decode;
+            result.preprocess = frame.preprocess;
+            result.estimate = elapsed(estimation);
+            result.latency = elapsed(frame.begin);
+
+            statistics.frames++;
+            statistics.decode += result.decode;
+            statistics.preprocess += result.preprocess;
+            statistics.estimate += result.estimate;
+            statistics.latency += result.latency;
+
+            callback(result);
+        }
+    } catch (...) {
+        cancel();
+        decoding.join();
+        preprocessing.join();
+        throw;
+    }
+
+    decoding.join();
+    preprocessing.join();
+
+    if (decoding_error) std::rethrow_exception(decoding_error);
+    if (preprocessing_error) std::rethrow_exception(preprocessing_error);
+
+    statistics.seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+    if (statistics.frames != 0) {
+        statistics.decode /= statistics.frames;
+        statistics.preprocess /= statistics.frames;
+        statistics.estimate /= statistics.frames;
+        statistics.latency /= statistics.frames;
+    }
+
+    return statistics;
+}
@@ -3,6 +3,7 @@
 //
 
 #include <limits>
+#include <cstdint>
 
 #include "util/MatrixFunctions.h"
 #include "GLCM.h"
@@ -35,203 +36,225 @@ int GLCM::Util::max_gray_value(const cv::Mat& image) {
 
 
 /**
- *  Splits image in subimages to evaluate their angles
+ *  Quantizes the values of a single channel image by shifting them (signed values get moved to start at 0 first)
  *
- *  TODO: replace with non hardcoded version!
+ *  REVIEW: Helper of GLCM::Util::quantize, T is the type of the image and Q the type of the quantized one
  */
-void GLCM::Util::split_image(const cv::Mat& image, std::vector<unsigned int>& angles, Implementation impl, Method meth,
-                                const Range& range, unsigned int max_r) {
-    std::vector<cv::Mat> mats;
-
-    if (meth == SPLIT_IMAGE_1x2) {
-        int middle_height = ceil(image.rows/2);
-
-        mats.emplace_back(image(cv::Range(0, middle_height), cv::Range(0, image.cols)));
-        mats.emplace_back(image(cv::Range(middle_height + 1, image.rows), cv::Range(0, image.cols)));
-    } else if (meth == SPLIT_IMAGE_1x3) {
-        int third_height = ceil(image.rows/3);
-
-        mats.emplace_back(image(cv::Range(0, third_height), cv::Range(0, image.cols)));
-        mats.emplace_back(image(cv::Range(third_height + 1, third_height * 2), cv::Range(0, image.cols)));
-        mats.emplace_back(image(cv::Range(third_height * 2 + 1, image.rows), cv::Range(0, image.cols)));
-    } else if (meth == SPLIT_IMAGE_1x4) {
-        int fourth_height = ceil(image.rows/4);
-
-        mats.emplace_back(image(cv::Range(0, fourth_height), cv::Range(0, image.cols)));
-        mats.emplace_back(image(cv::Range(fourth_height + 1, fourth_height * 2), cv::Range(0, image.cols)));
-        mats.emplace_back(image(cv::Range(fourth_height * 2 + 1, fourth_height * 3), cv::Range(0, image.cols)));
-        mats.emplace_back(image(cv::Range(fourth_height * 3 + 1, image.rows), cv::Range(0, image.cols)));
-    } else if (meth == SPLIT_IMAGE_2x1) {
-        int middle_width = ceil(image.cols/2);
-
-        mats.emplace_back(image(cv::Range(0, image.rows), cv::Range(0, middle_width)));
-        mats.emplace_back(image(cv::Range(0, image.rows), cv::Range(middle_width + 1, image.cols)));
-    } else if (meth == SPLIT_IMAGE_2x2) {
-        int middle_width = ceil(image.cols/2);
-        int middle_height = ceil(image.rows/2);
-
-        // First row left to right
-        mats.emplace_back(image(cv::Range(0, middle_height), cv::Range(0, middle_width)));
-        mats.emplace_back(image(cv::Range(0, middle_height), cv::Range(middle_width + 1, image.cols)));
-        // Second row left to right
-        mats.emplace_back(image(cv::Range(middle_height + 1, image.rows), cv::Range(0, middle_width)));
-        mats.emplace_back(image(cv::Range(middle_height + 1, image.rows), cv::Range(middle_width + 1, image.cols)));
-    } else if (meth == SPLIT_IMAGE_2x3) {
-        // TODO: implement
-        int middle_width = ceil(image.cols/2);
-        int third_height = ceil(image.rows/3);
-
-        // First row left to right
-        mats.emplace_back(image(cv::Range(0, third_height), cv::Range(0, middle_width)));
-        mats.emplace_back(image(cv::Range(0, third_height), cv::Range(middle_width + 1, image.cols)));
-        // Second row left to right
-        mats.emplace_back(image(cv::Range(third_height + 1, third_height * 2), cv::Range(0, middle_width)));
-        mats.emplace_back(image(cv::Range(third_height + 1, third_height * 2), cv::Range(middle_width + 1, image.cols)));
-        // Third row left to right
-        mats.emplace_back(image(cv::Range(third_height * 2 + 1, image.rows), cv::Range(0, middle_width)));
-        mats.emplace_back(image(cv::Range(third_height * 2 + 1, image.rows), cv::Range(middle_width + 1, image.cols)));
-    } else if (meth == SPLIT_IMAGE_2x4) {
-        // TODO: implement
-        int middle_width = ceil(image.cols/2);
-        int fourth_height = ceil(image.rows/4);
-
-        // First row left to right
-        mats.emplace_back(image(cv::Range(0, fourth_height), cv::Range(0, middle_width)));
-        mats.emplace_back(image(cv::Range(0, fourth_height), cv::Range(middle_width + 1, image.cols)));
-        // Second row left to right
-        mats.emplace_back(image(cv::Range(fourth_height + 1, fourth_height * 2), cv::Range(0, middle_width)));
-        mats.emplace_back(image(cv::Range(fourth_height + 1, fourth_height * 2), cv::Range(middle_width + 1, image.cols)));
-        // Third row left to right
-        mats.emplace_back(image(cv::Range(fourth_height * 2 + 1, fourth_height * 3), cv::Range(0, middle_width)));
-        mats.emplace_back(image(cv::Range(fourth_height * 2 + 1, fourth_height * 3), cv::Range(middle_width + 1, image.cols)));
-        // Fourth row left to right
-        mats.emplace_back(image(cv::Range(fourth_height * 3 + 1, image.rows), cv::Range(0, middle_width)));
-        mats.emplace_back(image(cv::Range(fourth_height * 3 + 1, image.rows), cv::Range(middle_width + 1, image.cols)));
-    } else if (meth == SPLIT_IMAGE_3x1) {
-        int third_width = ceil(image.cols/3);
-
-        mats.emplace_back(image(cv::Range(0, image.rows), cv::Range(0, third_width)));
-        mats.emplace_back(image(cv::Range(0, image.rows), cv::Range(third_width + 1, third_width * 2)));
-        mats.emplace_back(image(cv::Range(0, image.rows), cv::Range(third_width * 2 + 1, image.cols)));
-    } else if (meth == SPLIT_IMAGE_3x2) {
-        // TODO: implement
-        int third_width = ceil(image.cols/3);
-        int middle_height = ceil(image.rows/2);
-    } else if (meth == SPLIT_IMAGE_3x3) {
-        int third_width = ceil(image.cols/3);
-        int third_height = ceil(image.rows/3);
-
-        // First row left to right
-        mats.emplace_back(image(cv::Range(0, third_height), cv::Range(0, third_width)));
-        mats.emplace_back(image(cv::Range(0, third_height), cv::Range(third_width + 1, third_width * 2)));
-        mats.emplace_back(image(cv::Range(0, third_height), cv::Range(third_width * 2 + 1, image.cols)));
-        // Second row left to right
-        mats.emplace_back(image(cv::Range(third_height + 1, third_height * 2), cv::Range(0, third_width)));
-        mats.emplace_back(image(cv::Range(third_height + 1, third_height * 2), cv::Range(third_width + 1, third_width * 2)));
-        mats.emplace_back(image(cv::Range(third_height + 1, third_height * 2), cv::Range(third_width * 2 + 1, image.cols)));
-        // Third row left to right
-        mats.emplace_back(image(cv::Range(third_height * 2 + 1, image.rows), cv::Range(0, third_width)));
-        mats.emplace_back(image(cv::Range(third_height * 2 + 1, image.rows), cv::Range(third_width + 1, third_width * 2)));
-        mats.emplace_back(image(cv::Range(third_height * 2 + 1, image.rows), cv::Range(third_width * 2 + 1, image.cols)));
-    } else if (meth == SPLIT_IMAGE_3x4) {
-        // TODO: implement
-        int third_width = ceil(image.cols/3);
-        int fourth_height = ceil(image.rows/4);
-
-        // First row left to right
-        mats.emplace_back(image(cv::Range(0, fourth_height), cv::Range(0, third_width)));
-        mats.emplace_back(image(cv::Range(0, fourth_height), cv::Range(third_width + 1, third_width * 2)));
-        mats.emplace_back(image(cv::Range(0, fourth_height), cv::Range(third_width * 2 + 1, image.cols)));
-        // Second row left to right
-        mats.emplace_back(image(cv::Range(fourth_height + 1, fourth_height * 2), cv::Range(0, third_width)));
-        mats.emplace_back(image(cv::Range(fourth_height + 1, fourth_height * 2), cv::Range(third_width + 1, third_width * 2)));
-        mats.emplace_back(image(cv::Range(fourth_height + 1, fourth_height * 2), cv::Range(third_width * 2 + 1, image.cols)));
-        // Third row left to right
-        mats.emplace_back(image(cv::Range(fourth_height * 2 + 1, fourth_height * 3), cv::Range(0, third_width)));
-        mats.emplace_back(image(cv::Range(fourth_height * 2 + 1, fourth_height * 3), cv::Range(third_width + 1, third_width * 2)));
-        mats.emplace_back(image(cv::Range(fourth_height * 2 + 1, fourth_height * 3), cv::Range(third_width * 2 + 1, image.cols)));
-        // Fourth row left to right
-        mats.emplace_back(image(cv::Range(fourth_height * 3 + 1, image.rows), cv::Range(0, third_width)));
-        mats.emplace_back(image(cv::Range(fourth_height * 3 + 1, image.rows), cv::Range(third_width + 1, third_width * 2)));
-        mats.emplace_back(image(cv::Range(fourth_height * 3 + 1, image.rows), cv::Range(third_width * 2 + 1, image.cols)));
-    } else if (meth == SPLIT_IMAGE_4x1) {
-        int fourth_width = ceil(image.cols/4);
-
-        mats.emplace_back(image(cv::Range(0, image.rows), cv::Range(0, fourth_width)));
-        mats.emplace_back(image(cv::Range(0, image.rows), cv::Range(fourth_width + 1, fourth_width * 2)));
-        mats.emplace_back(image(cv::Range(0, image.rows), cv::Range(fourth_width * 2 + 1, fourth_width * 3)));
-        mats.emplace_back(image(cv::Range(0, image.rows), cv::Range(fourth_width * 3 + 1, image.cols)));
-    } else if (meth == SPLIT_IMAGE_4x2) {
-        // TODO: implement
-        int fourth_width = ceil(image.cols/4);
-        int middle_height = ceil(image.rows/2);
-
-        // First row left to right
-        mats.emplace_back(image(cv::Range(0, middle_height), cv::Range(0, fourth_width)));
-        mats.emplace_back(image(cv::Range(0, middle_height), cv::Range(fourth_width + 1, fourth_width * 2)));
-        mats.emplace_back(image(cv::Range(0, middle_height), cv::Range(fourth_width * 2 + 1, fourth_width * 3)));
-        mats.emplace_back(image(cv::Range(0, middle_height), cv::Range(fourth_width * 3 + 1, image.cols)));
-        // Second row left to right
-        mats.emplace_back(image(cv::Range(middle_height + 1, image.rows), cv::Range(0, fourth_width)));
-        mats.emplace_back(image(cv::Range(middle_height + 1, image.rows), cv::Range(fourth_width + 1, fourth_width * 2)));
-        mats.emplace_back(image(cv::Range(middle_height + 1, image.rows), cv::Range(fourth_width * 2 + 1, fourth_width * 3)));
-        mats.emplace_back(image(cv::Range(middle_height + 1, image.rows), cv::Range(fourth_width * 3 + 1, image.cols)));
-    } else if (meth == SPLIT_IMAGE_4x3) {
-        // TODO: implement
-        int fourth_width = ceil(image.cols/4);
-        int third_height = ceil(image.rows/3);
-
-        // First row left to right
-        mats.emplace_back(image(cv::Range(0, third_height), cv::Range(0, fourth_width)));
-        mats.emplace_back(image(cv::Range(0, third_height), cv::Range(fourth_width + 1, fourth_width * 2)));
-        mats.emplace_back(image(cv::Range(0, third_height), cv::Range(fourth_width * 2 + 1, fourth_width * 3)));
-        mats.emplace_back(image(cv::Range(0, third_height), cv::Range(fourth_width * 3 + 1, image.cols)));
-        // Second row left to right
-        mats.emplace_back(image(cv::Range(third_height + 1, third_height * 2), cv::Range(0, fourth_width)));
-        mats.emplace_back(image(cv::Range(third_height + 1, third_height * 2), cv::Range(fourth_width + 1, fourth_width * 2)));
-        mats.emplace_back(image(cv::Range(third_height + 1, third_height * 2), cv::Range(fourth_width * 2 + 1, fourth_width * 3)));
-        mats.emplace_back(image(cv::Range(third_height + 1, third_height * 2), cv::Range(fourth_width * 3 + 1, image.cols)));
-        // Third row left to right
-        mats.emplace_back(image(cv::Range(third_height * 2 + 1, image.rows), cv::Range(0, fourth_width)));
-        mats.emplace_back(image(cv::Range(third_height * 2 + 1, image.rows), cv::Range(fourth_width + 1, fourth_width * 2)));
-        mats.emplace_back(image(cv::Range(third_height * 2 + 1, image.rows), cv::Range(fourth_width * 2 + 1, fourth_width * 3)));
-        mats.emplace_back(image(cv::Range(third_height * 2 + 1, image.rows), cv::Range(fourth_width * 3 + 1, image.cols)));
-    } else if (meth == SPLIT_IMAGE_4x4) {
-        int fourth_width = ceil(image.cols/4);
-        int fourth_height = ceil(image.rows/4);
-
-        // First row left to right
-        mats.emplace_back(image(cv::Range(0, fourth_height), cv::Range(0, fourth_width)));
-        mats.emplace_back(image(cv::Range(0, fourth_height), cv::Range(fourth_width + 1, fourth_width * 2)));
-        mats.emplace_back(image(cv::Range(0, fourth_height), cv::Range(fourth_width * 2 + 1, fourth_width * 3)));
-        mats.emplace_back(image(cv::Range(0, fourth_height), cv::Range(fourth_width * 3 + 1, image.cols)));
-        // Second row left to right
-        mats.emplace_back(image(cv::Range(fourth_height + 1, fourth_height * 2), cv::Range(0, fourth_width)));
-        mats.emplace_back(image(cv::Range(fourth_height + 1, fourth_height * 2), cv::Range(fourth_width + 1, fourth_width * 2)));
-        mats.emplace_back(image(cv::Range(fourth_height + 1, fourth_height * 2), cv::Range(fourth_width * 2 + 1, fourth_width * 3)));
-        mats.emplace_back(image(cv::Range(fourth_height + 1, fourth_height * 2), cv::Range(fourth_width * 3 + 1, image.cols)));
-        // Third row left to right
-        mats.emplace_back(image(cv::Range(fourth_height * 2 + 1, fourth_height * 3), cv::Range(0, fourth_width)));
-        mats.emplace_back(image(cv::Range(fourth_height * 2 + 1, fourth_height * 3), cv::Range(fourth_width + 1, fourth_width * 2)));
-        mats.emplace_back(image(cv::Range(fourth_height * 2 + 1, fourth_height * 3), cv::Range(fourth_width * 2 + 1, fourth_width * 3)));
-        mats.emplace_back(image(cv::Range(fourth_height * 2 + 1, fourth_height * 3), cv::Range(fourth_width * 3 + 1, image.cols)));
-        // Fourth row left to right
-        mats.emplace_back(image(cv::Range(fourth_height * 3 + 1, image.rows), cv::Range(0, fourth_width)));
-        mats.emplace_back(image(cv::Range(fourth_height * 3 + 1, image.rows), cv::Range(fourth_width + 1, fourth_width * 2)));
-        mats.emplace_back(image(cv::Range(fourth_height * 3 + 1, image.rows), cv::Range(fourth_width * 2 + 1, fourth_width * 3)));
-        mats.emplace_back(image(cv::Range(fourth_height * 3 + 1, image.rows), cv::Range(fourth_width * 3 + 1, image.cols)));
-    } else {
-        // TODO: Happens when new and not implemented methods are used!
-        throw std::runtime_error("[GLCM::Util::split_image] Unsupported (unimplemented) image splitting method!");
+template <typename T, typename Q>
+static void quantize_values(const cv::Mat& image, cv::Mat& quantized, int shift) {
+    const std::int64_t offset = -static_cast<std::int64_t>(std::numeric_limits<T>::min());
+
+    #pragma omp parallel for
+    for (int y = 0; y < image.rows; y++) {
+        const T* src = image.ptr<T>(y);
+        Q* dst = quantized.ptr<Q>(y);
+
+        for (int x = 0; x < image.cols; x++) {
+            dst[x] = static_cast<Q>((static_cast<std::int64_t>(src[x]) + offset) >> shift);
+        }
+    }
+}
+
+
+/**
+ *  Quantizes the image to the given number of gray levels
+ *
+ *  REVIEW: 8 bit images use a lookup table, every other type shifts its values
+ */
+cv::Mat GLCM::Util::quantize(const cv::Mat& image, unsigned int levels) {
+    cv::Mat quantized;
+    quantize(image, levels, quantized);
+
+    return quantized;
+}
+
+
+/**
+ *  Quantizes the image to the given number of gray levels into a buffer
+ *
+ *  REVIEW: 8 bit images use a lookup table (on the stack), every other type shifts its values
+ */
+void GLCM::Util::quantize(const cv::Mat& image, unsigned int levels, cv::Mat& quantized) {
+    int bits;
+    switch (image.type() & CV_MAT_DEPTH_MASK) {
+        case CV_8S:
+        case CV_8U:
+            bits = 8;
+            break;
+        case CV_16S:
+        case CV_16U:
+            bits = 16;
+            break;
+        case CV_32S:
+            bits = 32;
+            break;
+        default:
+            throw std::runtime_error("[GLCM::Util::quantize] Unsupported Mat-type!");
+    }
+
+    int level_bits = 0;
+    while ((1ULL << level_bits) < levels) level_bits++;
+
+    if (levels == 0 || (1ULL << level_bits) != levels || level_bits > std::min(bits, 16)) {
+        throw std::invalid_argument("[GLCM::Util::quantize] Number of levels has to be a power of 2 (up to 2^16 and "
+                                    "the number of possible gray values)!");
     }
 
-    #pragma omp declare reduction (vector_push_back: \
-                                    std::vector<unsigned int> : omp_out.insert(         \
-                                        omp_out.end(), omp_in.begin(), omp_in.end()     \
-                                    ))
+    int shift = bits - level_bits;
+    quantized.create(image.rows, image.cols, levels <= 256 ? CV_8UC1 : CV_16UC1);
+
+    switch (image.type() & CV_MAT_DEPTH_MASK) {
+        case CV_8U: {
+            uchar table[256];
+            for (int i = 0; i < 256; i++) table[i] = static_cast<uchar>(i >> shift);
+
+            cv::Mat lut(1, 256, CV_8UC1, table);
 
-    #pragma omp parallel for reduction(vector_push_back: angles)
-    for (int i = 0; i < mats.size(); i++) {
-        angles.push_back(GLCM::main_angle(mats.at(i), impl, range, max_r));
+            cv::LUT(image, lut, quantized);
+            break;
+        }
+        case CV_8S:
+            quantize_values<char, uchar>(image, quantized, shift);
+            break;
+        case CV_16S:
+            if (levels <= 256) quantize_values<short, uchar>(image, quantized, shift);
+            else quantize_values<short, ushort>(image, quantized, shift);
+            break;
+        case CV_16U:
+            if (levels <= 256) quantize_values<ushort, uchar>(image, quantized, shift);
+            else quantize_values<ushort, ushort>(image, quantized, shift);
+            break;
+        case CV_32S:
+            if (levels <= 256) quantize_values<int, uchar>(image, quantized, shift);
+            else quantize_values<int, ushort>(image, quantized, shift);
+            break;
     }
-}
\ No newline at end of file
+}
+
+
+/**
+ *  Moves the gray values of the image to the range actually occupied
+ *
+ *  REVIEW: Standard and Scheme 3 (rounding the interpolated partner once) only depend on the differences of gray
+ *          values => shifting all of them does not change Z
+ *  NOBUG:  Scheme 2 truncates every weighted gray value of the interpolation on its own => Z of the shifted image
+ *          may differ slightly (see GLCM::prepare_image, compacting for the MATRIX engine only)
+ *  REVIEW: Single scan for minimum and maximum, the shift itself is exact (every int fits into a double)
+ */
+cv::Mat GLCM::Util::compact(const cv::Mat& image, int& levels) {
+    cv::Mat compacted;
+    compact(image, levels, compacted);
+
+    return compacted;
+}
+
+
+/**
+ *  Moves the gray values of the image to the range actually occupied into a buffer
+ *
+ *  REVIEW: convertTo only reallocates the buffer if its size or type does not fit
+ */
+void GLCM::Util::compact(const cv::Mat& image, int& levels, cv::Mat& compacted) {
+    switch (image.type() & CV_MAT_DEPTH_MASK) {
+        case CV_8S:
+        case CV_8U:
+        case CV_16S:
+        case CV_16U:
+        case CV_32S:
+            break;
+        default:
+            throw std::runtime_error("[GLCM::Util::compact] Unsupported Mat-type!");
+    }
+
+    double min = 0, max = 0;
+    if (!image.empty()) cv::minMaxLoc(image, &min, &max);
+
+    double occupied = max - min + 1;
+    if (occupied > std::numeric_limits<int>::max()) {
+        throw std::invalid_argument("[GLCM::Util::compact] Occupied range of gray values too large, quantize the "
+                                    "image first (see GLCM::Options::levels)!");
+    }
+
+    check_exact_range(max - min, image.total());
+    levels = static_cast<int>(occupied);
+
+    int depth = levels <= 256 ? CV_8U : (levels <= 65536 ? CV_16U : CV_32S);
+    image.convertTo(compacted, depth, 1.0, -min);
+}
+
+
+/**
+ *  Checks whether every degree of concentration of an image stays exact
+ *
+ *  REVIEW: Everything in double => the product itself cannot overflow, 2^53 is exactly representable
+ */
+void GLCM::Util::check_exact_range(double range, size_t pixels) {
+    if (range * range * static_cast<double>(pixels) > 9007199254740992.0) {
+        throw std::invalid_argument("[GLCM::Util::check_exact_range] Range of gray values too wide for exact sums, "
+                                    "quantize the image (see GLCM::Options::levels)!");
+    }
+}
+
+
+/**
+ *  Splits an image into a grid of sub-images
+ *
+ *  REVIEW: Boundaries are i * size / n => no row or column gets dropped, whatever the size of the image is
+ */
+std::vector<cv::Rect> GLCM::Util::grid(const cv::Size& size, const cv::Size& grid) {
+    if (grid.width <= 0 || grid.height <= 0 || grid.width > size.width || grid.height > size.height) {
+        throw std::invalid_argument("[GLCM::Util::grid] Grid has to be positive and not exceed the image size!");
+    }
+
+    std::vector<cv::Rect> rects;
+    rects.reserve(static_cast<size_t>(grid.width) * grid.height);
+
+    for (int y = 0; y < grid.height; y++) {
+        int top = static_cast<int>(static_cast<long>(y) * size.height / grid.height);
+        int bottom = static_cast<int>(static_cast<long>(y + 1) * size.height / grid.height);
+
+        for (int x = 0; x < grid.width; x++) {
+            int left = static_cast<int>(static_cast<long>(x) * size.width / grid.width);
+            int right = static_cast<int>(static_cast<long>(x + 1) * size.width / grid.width);
+
+            rects.emplace_back(left, top, right - left, bottom - top);
+        }
+    }
+
+    return rects;
+}
+
+
+/**
+ *  Splits image in subimages to evaluate their angles
+ *
+ *  REVIEW: Every sub-image gets its distribution from the same pass over the image (see GLCM::main_angle_rois)
+ */
+void GLCM::Util::split_image(const cv::Mat& image, std::vector<unsigned int>& angles, Implementation impl, Method meth,
+                                const Range& range, unsigned int max_r, const Options& options) {
+    cv::Size size;
+
+    switch (meth) {
+        case SPLIT_IMAGE_1x2: size = cv::Size(1, 2); break;
+        case SPLIT_IMAGE_1x3: size = cv::Size(1, 3); break;
+        case SPLIT_IMAGE_1x4: size = cv::Size(1, 4); break;
+        case SPLIT_IMAGE_2x1: size = cv::Size(2, 1); break;
+        case SPLIT_IMAGE_2x2: size = cv::Size(2, 2); break;
+        case SPLIT_IMAGE_2x3: size = cv::Size(2, 3); break;
+        case SPLIT_IMAGE_2x4: size = cv::Size(2, 4); break;
+        case SPLIT_IMAGE_3x1: size = cv::Size(3, 1); break;
+        case SPLIT_IMAGE_3x2: size = cv::Size(3, 2); break;
+        case SPLIT_IMAGE_3x3: size = cv::Size(3, 3); break;
+        case SPLIT_IMAGE_3x4: size = cv::Size(3, 4); break;
+        case SPLIT_IMAGE_4x1: size = cv::Size(4, 1); break;
+        case SPLIT_IMAGE_4x2: size = cv::Size(4, 2); break;
+        case SPLIT_IMAGE_4x3: size = cv::Size(4, 3); break;
+        case SPLIT_IMAGE_4x4: size = cv::Size(4, 4); break;
+        default:
+            // TODO: Happens when new and not implemented methods are used!
+            throw std::runtime_error("[GLCM::Util::split_image] Unsupported (unimplemented) image splitting method!");
+    }
+
+    std::vector<unsigned int> found = GLCM::main_angle_grid(image, impl, size, range, max_r, options);
+    angles.insert(angles.end(), found.begin(), found.end());
+}
@@ -0,0 +1,115 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+#include <algorithm>
+
+#include "util/SimdFunctions.h"
+
+
+/**
+ *  REVIEW: Plain loops on purpose, every clone gets vectorized by the compiler for its own instruction set
+ *          (see CMakeLists.txt, this file is always optimized)
+ */
+
+
+/// Squared differences of 8 bit spans: 32 bit lanes, flushed before they could overflow (65536 * 255^2 < 2^32)
+AIOLOS_TARGET_CLONES
+std::uint64_t GLCM::Util::squared_differences(const uchar* a, const uchar* b, int n) {
+    std::uint64_t value = 0;
+
+    for (int begin = 0; begin < n; begin += 65536) {
+        int end = std::min(n, begin + 65536);
+        std::uint32_t block = 0;
+
+        for (int i = begin; i < end; i++) {
+            int diff = static_cast<int>(a[i]) - static_cast<int>(b[i]);
+            block += static_cast<std::uint32_t>(diff * diff);
+        }
+
+        value += block;
+    }
+
+    return value;
+}
+
+
+/// Squared differences of 16 bit spans: 64 bit lanes (a single 65535^2 nearly fills 32 bit)
+AIOLOS_TARGET_CLONES
+std::uint64_t GLCM::Util::squared_differences(const ushort* a, const ushort* b, int n) {
+    std::uint64_t value = 0;
+
+    for (int i = 0; i < n; i++) {
+        std::int64_t diff = static_cast<int>(a[i]) - static_cast<int>(b[i]);
+        value += static_cast<std::uint64_t>(diff * diff);
+    }
+
+    return value;
+}
+
+
+/**
+ *  Interpolated squared differences of 8 bit spans
+ *
+ *  REVIEW: Weights are never negative and the interpolated values fit into an int => truncating to int equals the
+ *          truncation to unsigned int of the generic version (but can be vectorized)
+ */
+AIOLOS_TARGET_CLONES
+std::uint64_t GLCM::Util::interpolated_squared_differences(const uchar* row, const uchar* row_1, const uchar* row_2,
+                                                           int n, double c_1, double c_2, double c_3, double c_4) {
+    std::uint64_t value = 0;
+
+    for (int i = 0; i < n; i++) {
+        int gray = static_cast<int>(c_1 * row_1[i]) + static_cast<int>(c_2 * row_1[i + 1])
+                   + static_cast<int>(c_3 * row_2[i]) + static_cast<int>(c_4 * row_2[i + 1]);
+
+        std::int64_t diff = static_cast<int>(row[i]) - gray;
+        value += static_cast<std::uint64_t>(diff * diff);
+    }
+
+    return value;
+}
+
+
+/// Interpolated squared differences of 16 bit spans (see 8 bit version)
+AIOLOS_TARGET_CLONES
+std::uint64_t GLCM::Util::interpolated_squared_differences(const ushort* row, const ushort* row_1, const ushort* row_2,
+                                                           int n, double c_1, double c_2, double c_3, double c_4) {
+    std::uint64_t value = 0;
+
+    for (int i = 0; i < n; i++) {
+        int gray = static_cast<int>(c_1 * row_1[i]) + static_cast<int>(c_2 * row_1[i + 1])
+                   + static_cast<int>(c_3 * row_2[i]) + static_cast<int>(c_4 * row_2[i + 1]);
+
+        std::int64_t diff = static_cast<int>(row[i]) - gray;
+        value += static_cast<std::uint64_t>(diff * diff);
+    }
+
+    return value;
+}
+
+
+/**
+ *  Interpolation of 8 bit partners
+ *
+ *  REVIEW: Weights are never negative => adding 0.5 and truncating equals rounding (but can be vectorized)
+ */
+AIOLOS_TARGET_CLONES
+void GLCM::Util::interpolate(const uchar* row_1, const uchar* row_2, int n, double c_1, double c_2, double c_3,
+                             double c_4, uchar* partners) {
+    for (int i = 0; i < n; i++) {
+        partners[i] = static_cast<uchar>(static_cast<int>(c_1 * row_1[i] + c_2 * row_1[i + 1]
+                                                          + c_3 * row_2[i] + c_4 * row_2[i + 1] + 0.5));
+    }
+}
+
+
+/// Interpolation of 16 bit partners (see 8 bit version)
+AIOLOS_TARGET_CLONES
+void GLCM::Util::interpolate(const ushort* row_1, const ushort* row_2, int n, double c_1, double c_2, double c_3,
+                             double c_4, ushort* partners) {
+    for (int i = 0; i < n; i++) {
+        partners[i] = static_cast<ushort>(static_cast<int>(c_1 * row_1[i] + c_2 * row_1[i + 1]
+                                                           + c_3 * row_2[i] + c_4 * row_2[i + 1] + 0.5));
+    }
+}
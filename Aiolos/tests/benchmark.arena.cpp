@@ -0,0 +1,113 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <chrono>
+#include <opencv2/opencv.hpp>
+#include <impl/Standard.h>
+#include <impl/Arena.h>
+
+using namespace std;
+using namespace cv;
+
+
+/// Degree of concentration of the given rows of a GLCM (same for every variant => nothing gets optimized away)
+double concentration(const Mat_<int>& glcm, int first, int last) {
+    double value = 0;
+
+    for (int y = first; y < last; y++) {
+        for (int x = 0; x < glcm.cols; x++) value += static_cast<double>(y - x) * (y - x) * glcm(y, x);
+    }
+
+    return value;
+}
+
+
+/**
+ *  Zeroing cost of the scratch GLCM of every work item (band of rows) of a 16 bit image spanning 1024 gray levels:
+ *  a new GLCM per item, zeroing the range of gray values of the whole image and zeroing only the rows written by
+ *  the previous item (GLCM::arena_glcm)
+ */
+int main() {
+    const int max_gray = 1024, band_height = 16, repetitions = 10;
+
+    // Gradient from top to bottom plus noise => every band only occupies a small part of the gray values
+    Mat_<ushort> image(512, 512);
+    RNG rng(42);
+    for (int y = 0; y < image.rows; y++) {
+        for (int x = 0; x < image.cols; x++) {
+            int gray = y * (max_gray - 1) / (image.rows - 1) + rng.uniform(-8, 9);
+            image(y, x) = static_cast<ushort>(std::min(std::max(gray, 0), max_gray - 1));
+        }
+    }
+
+    GLCM::Offset offset = GLCM::make_offset(5, 30 * CV_PI / 180);
+    int bands = (image.rows + band_height - 1) / band_height;
+
+    double min_gray, max_gray_value;
+    minMaxLoc(image, &min_gray, &max_gray_value);
+
+    auto run = [&](const char* name, auto item) {
+        double z = 0;
+
+        auto begin = chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; i++) {
+            for (int band = 0; band < bands; band++) {
+                z += item(Range(band * band_height, min(image.rows, (band + 1) * band_height)));
+            }
+        }
+        double time = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now()-begin).count();
+
+        cout << "Durch. Zeit (" << name << "): " << time / (repetitions * bands) << " Mikrosekunden pro Band" << endl;
+        return z;
+    };
+
+    // Before the arena: every work item creates (and zeroes) a GLCM of its own
+    double z_new = run("neue GLCM", [&](const Range& rows) {
+        Mat_<int> glcm(max_gray, max_gray, 0);
+        GLCM::Standard::GLCM(image, glcm, offset, rows);
+        return concentration(glcm, 0, max_gray);
+    });
+
+    // Range of gray values of the whole image => every row after compaction
+    Mat_<int> reused(max_gray, max_gray, 0);
+    double z_range = run("Grauwerte des Bildes", [&](const Range& rows) {
+        for (int y = static_cast<int>(min_gray); y <= static_cast<int>(max_gray_value); y++) {
+            std::memset(reused[y], 0, max_gray * sizeof(int));
+        }
+
+        GLCM::Standard::GLCM(image, reused, offset, rows);
+        return concentration(reused, static_cast<int>(min_gray), static_cast<int>(max_gray_value) + 1);
+    });
+
+    // Only the rows written by the previous item get zeroed
+    long touched = 0;
+    double z_arena = run("geschriebene Zeilen", [&](const Range& rows) {
+        auto& glcm = GLCM::arena_glcm<Mat_<int>>(max_gray);
+        GLCM::Standard::GLCM(image, glcm, offset, rows);
+
+        double value = 0;
+        for (int y = 0; y < glcm.rows; y++) {
+            if (!glcm.touched_row(y)) continue;
+            touched++;
+
+            for (int x = 0; x < glcm.cols; x++) value += static_cast<double>(y - x) * (y - x) * glcm[y][x];
+        }
+
+        return value;
+    });
+
+    cout << "Geschriebene Zeilen pro Band: " << static_cast<double>(touched) / (repetitions * bands)
+         << " von " << max_gray << endl;
+
+    if (z_new != z_range || z_new != z_arena) {
+        cout << "Unterschiedliche Ergebnisse: " << z_new << " " << z_range << " " << z_arena << endl;
+        return 1;
+    }
+
+    return 0;
+}
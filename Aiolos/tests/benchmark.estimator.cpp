@@ -0,0 +1,76 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+#include <iostream>
+#include <cstdlib>
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <opencv2/opencv.hpp>
+#include <GLCM.h>
+#include <Estimator.h>
+#include <util/TestHelper.h>
+
+using namespace std;
+using namespace cv;
+
+
+/// Number of heap allocations of the whole program (every thread)
+static atomic<long> allocations(0);
+
+void* operator new(size_t size) {
+    allocations++;
+
+    void* pointer = malloc(size != 0 ? size : 1);
+    if (pointer == nullptr) throw bad_alloc();
+
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept { free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { free(pointer); }
+
+
+/**
+ *  Heap allocations and time per frame of a video (same size and type every frame): GLCM::main_angle per frame
+ *  against a single GLCM::Estimator reused for every frame
+ *
+ *  REVIEW: Only allocations using operator new get counted (OpenCV allocates the data of every cv::Mat itself)
+ */
+int main() {
+    const int frames = 20;
+
+    Mat_<uchar> base = stripes(Size(256, 256));
+
+    for (GLCM::Engine engine : {GLCM::MATRIX, GLCM::DIFFERENCE}) {
+        GLCM::Options options;
+        options.engine = engine;
+
+        GLCM::Estimator estimator(GLCM::SCHEME2, GLCM::Range(0, 179), 20, options);
+        estimator.estimate(base);       // first frame of the size allocates every buffer
+
+        auto measure = [&](const char* name, auto estimate) {
+            long before = allocations;
+            unsigned int angle = 0;
+
+            auto begin = chrono::steady_clock::now();
+            for (int i = 0; i < frames; i++) angle = estimate(base);
+            double time = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now()-begin).count();
+
+            cout << "Engine " << engine << ", " << name << ": Winkel " << angle << "°, "
+                 << static_cast<double>(allocations - before) / frames << " Allokationen, "
+                 << time / frames / 1000 << " Millisekunden pro Bild" << endl;
+        };
+
+        measure("main_angle", [&](const Mat& frame) {
+            return GLCM::main_angle(frame, GLCM::SCHEME2, GLCM::Range(0, 179), 20, options);
+        });
+
+        measure("Estimator", [&](const Mat& frame) {
+            return estimator.estimate(frame);
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+#include <iostream>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include <GLCM.h>
+#include <util/TestHelper.h>
+
+using namespace std;
+using namespace cv;
+
+
+/// Compares the distributions of two engines, every value is an exact integer => has to be equal
+bool compare(const char* name, const Mat& image, int impl, int engine, unsigned int levels = 0) {
+    vector<double> matrix = c_distribution(image, impl, GLCM::MATRIX, levels, 20);
+    vector<double> other = c_distribution(image, impl, engine, levels, 20);
+
+    return report(!matrix.empty() && matrix == other, name, " (Implementierung ", impl, ", Engine ", engine, ")");
+}
+
+
+/**
+ *  The degree of concentration of every angle has to be the same for every engine (8 and 16 bit images)
+ */
+int main() {
+    RNG rng(7);
+
+    // Stripes plus noise => a distinct dominant angle
+    Mat_<uchar> image8(64, 80);
+    Mat_<ushort> image16(64, 80);
+    Mat_<int> image32(64, 80), wide(64, 80);
+    for (int y = 0; y < image8.rows; y++) {
+        for (int x = 0; x < image8.cols; x++) {
+            image8(y, x) = saturate_cast<uchar>(((x * 3 + y * 5) % 48) * 4 + rng.uniform(0, 40));
+            image16(y, x) = saturate_cast<ushort>(((x * 3 + y * 5) % 48) * 900 + rng.uniform(0, 9000));
+            image32(y, x) = image8(y, x) * 1000 - 5000000;
+            wide(y, x) = image8(y, x) * (1 << 22) - (1 << 29);
+        }
+    }
+
+    bool passed = true;
+
+    for (int impl : {GLCM::STANDARD, GLCM::SCHEME1, GLCM::SCHEME2, GLCM::SCHEME3}) {
+        passed &= compare("8 Bit", image8, impl, GLCM::DIFFERENCE);
+    }
+
+    // Scheme 1 and Scheme 2 are not invariant to the compaction of the MATRIX engine (see README)
+    for (int impl : {GLCM::STANDARD, GLCM::SCHEME3}) {
+        passed &= compare("16 Bit", image16, impl, GLCM::DIFFERENCE);
+        passed &= compare("16 Bit, 64 Stufen", image16, impl, GLCM::DIFFERENCE, 64);
+    }
+
+    // Signed 32 bit gets compacted for every engine, too wide ranges have to be quantized (no silent overflow)
+    for (int impl : {GLCM::STANDARD, GLCM::SCHEME1, GLCM::SCHEME2, GLCM::SCHEME3}) {
+        passed &= compare("32 Bit", image32, impl, GLCM::DIFFERENCE);
+    }
+
+    bool rejected = c_distribution(wide, GLCM::STANDARD, GLCM::DIFFERENCE, 0, 20).empty();
+    cout << "32 Bit, zu breiter Bereich: " << (rejected ? "abgelehnt" : "FEHLER") << endl;
+    passed &= rejected && compare("32 Bit, 256 Stufen", wide, GLCM::STANDARD, GLCM::DIFFERENCE, 256);
+
+    // Autocorrelation (Standard only) gets used up to 256 gray levels, DIFFERENCE above
+    passed &= compare("8 Bit", image8, GLCM::STANDARD, GLCM::AUTOCORRELATION);
+    passed &= compare("16 Bit", image16, GLCM::STANDARD, GLCM::AUTOCORRELATION);
+    passed &= compare("16 Bit, 64 Stufen", image16, GLCM::STANDARD, GLCM::AUTOCORRELATION, 64);
+
+    return passed ? 0 : 1;
+}
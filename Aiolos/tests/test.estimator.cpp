@@ -0,0 +1,93 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <opencv2/opencv.hpp>
+#include <GLCM.h>
+#include <Estimator.h>
+#include <util/TestHelper.h>
+
+using namespace std;
+using namespace cv;
+
+
+/**
+ *  Every image calculated by the same estimator has to give the same angle as GLCM::main_angle and the same
+ *  distribution as calculated without an estimator (images of another size and type in between)
+ *
+ *  @param images       the given images
+ *  @param impl         which implementation of the GLCM shall be used
+ *  @param options      additional settings (engine, levels, search)
+ *  @return             whether every image is the same
+ */
+bool compare(const vector<Mat>& images, GLCM::Implementation impl, const GLCM::Options& options) {
+    GLCM::Estimator estimator(impl, GLCM::Range(0, 179), 8, options);
+    bool same = true;
+
+    for (const Mat& image : images) {
+        same &= estimator.estimate(image) == GLCM::main_angle(image, impl, GLCM::Range(0, 179), 8, options);
+
+        vector<double> values(180);
+        estimator.distribution(image, values.data());
+        same &= values == c_distribution(image, impl, options.engine, options.levels, 8);
+    }
+
+    return report(same, "Implementierung ", impl, ", Engine ", options.engine, ", Stufen ", options.levels,
+                  ", Suche ", options.search);
+}
+
+
+int main() {
+    Mat_<uchar> base = stripes(Size(70, 60));
+    Mat_<ushort> deep(50, 40);
+    for (int y = 0; y < deep.rows; y++) {
+        for (int x = 0; x < deep.cols; x++) deep(y, x) = static_cast<ushort>((x * 131 + y * 71 + x * y * 7) % 4000);
+    }
+
+    // Same size again and again (buffers reused), then another size and type
+    vector<Mat> images;
+    for (int i = 0; i < 3; i++) {
+        Mat_<uchar> frame = base.clone();
+        frame(i, i) = static_cast<uchar>(i * 50);
+        images.push_back(frame);
+    }
+    images.push_back(deep);
+    images.push_back(base);
+
+    bool passed = true;
+
+    for (GLCM::Implementation impl : {GLCM::STANDARD, GLCM::SCHEME1, GLCM::SCHEME2, GLCM::SCHEME3}) {
+        for (GLCM::Engine engine : {GLCM::MATRIX, GLCM::DIFFERENCE}) {
+            GLCM::Options plain, quantized, coarse;
+            plain.engine = quantized.engine = coarse.engine = engine;
+            quantized.levels = 16;
+            coarse.search = GLCM::COARSE_TO_FINE;
+
+            passed &= compare(images, impl, plain);
+            passed &= compare(images, impl, quantized);
+            passed &= compare(images, impl, coarse);
+        }
+    }
+
+    // Concurrent calls of the same estimator get serialized
+    GLCM::Estimator shared(GLCM::SCHEME2, GLCM::Range(0, 179), 8);
+    unsigned int expected = GLCM::main_angle(base, GLCM::SCHEME2, GLCM::Range(0, 179), 8);
+    atomic<int> wrong(0);
+
+    vector<thread> callers;
+    for (int t = 0; t < 4; t++) {
+        callers.emplace_back([&]() {
+            for (int i = 0; i < 5; i++) {
+                if (shared.estimate(base) != expected) wrong++;
+            }
+        });
+    }
+    for (thread& caller : callers) caller.join();
+
+    passed &= report(wrong == 0, "Gleichzeitige Aufrufe");
+    return passed ? 0 : 1;
+}
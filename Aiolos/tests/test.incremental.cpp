@@ -0,0 +1,76 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+#include <iostream>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include <GLCM.h>
+#include <Incremental.h>
+#include <util/TestHelper.h>
+
+using namespace std;
+using namespace cv;
+
+
+/**
+ *  Every frame updated incrementally has to give the same distribution as the frame calculated completely (a second
+ *  estimator reset before every frame) and the same angle as GLCM::main_angle
+ *
+ *  @param base         the first frame
+ *  @param impl         which implementation of the GLCM shall be used (all but Scheme 1)
+ *  @param options      additional settings (levels and radius schedule)
+ *  @return             whether every frame is the same
+ */
+bool compare(const Mat_<uchar>& base, GLCM::Implementation impl, const GLCM::Options& options) {
+    GLCM::IncrementalEstimator incremental(impl, GLCM::Range(0, 179), 8, options, 8);
+    GLCM::IncrementalEstimator complete(impl, GLCM::Range(0, 179), 8, options, 8);
+
+    Mat_<uchar> frame = base.clone();
+    bool same = true;
+    double recalculated = 0;
+
+    for (int i = 0; i < 8; i++) {
+        // A few rows change from frame to frame, the fifth frame returns to the first one
+        if (i > 0) {
+            int first = (i * 13) % (frame.rows - 3);
+            for (int y = first; y < first + 3; y++) {
+                for (int x = 0; x < frame.cols; x++) {
+                    frame(y, x) = static_cast<uchar>((frame(y, x) * 3 + i * 17 + y * x) % 256);
+                }
+            }
+        }
+        if (i == 5) frame = base.clone();
+
+        unsigned int angle = incremental.update(frame);
+        if (i > 0) recalculated += incremental.recalculated();
+
+        complete.reset();
+        complete.update(frame);
+
+        same &= incremental.distribution() == complete.distribution()
+                && angle == GLCM::main_angle(frame, impl, GLCM::Range(0, 179), 8, options);
+    }
+
+    // Only a few rows change => most of the work items have to be reused
+    return report(same && recalculated / 7 < 0.5, "Implementierung ", impl, ", Stufen ", options.levels,
+                  ", neu berechnet ", recalculated / 7);
+}
+
+
+int main() {
+    Mat_<uchar> base = stripes(Size(70, 60));
+
+    GLCM::Options plain, quantized;
+    quantized.levels = 16;
+    quantized.schedule = GLCM::STRIDE;
+
+    bool passed = true;
+
+    for (GLCM::Implementation impl : {GLCM::STANDARD, GLCM::SCHEME2, GLCM::SCHEME3}) {
+        passed &= compare(base, impl, plain);
+        passed &= compare(base, impl, quantized);
+    }
+
+    return passed ? 0 : 1;
+}
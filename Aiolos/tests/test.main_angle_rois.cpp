@@ -0,0 +1,68 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <opencv2/opencv.hpp>
+#include <GLCM.h>
+#include <util/TestHelper.h>
+
+using namespace std;
+using namespace cv;
+
+
+/**
+ *  Every angle of GLCM::main_angle_rois has to equal GLCM::main_angle of its region cut out of the image
+ *
+ *  @param image        the given image
+ *  @param rois         the regions (overlapping, touching the border of the image)
+ *  @param impl         which implementation of the GLCM shall be used
+ *  @param max_r        fixed maximum radius or 0
+ *  @param options      additional settings (radius schedule)
+ *  @return             whether every angle is the same
+ */
+bool compare(const Mat& image, const vector<Rect>& rois, GLCM::Implementation impl, unsigned int max_r,
+             GLCM::Options options) {
+    vector<unsigned int> angles = GLCM::main_angle_rois(image, rois, impl, GLCM::Range(0, 179), max_r, options);
+
+    bool same = angles.size() == rois.size();
+    for (size_t i = 0; same && i < rois.size(); i++) {
+        same &= angles[i] == GLCM::main_angle(image(rois[i]), impl, GLCM::Range(0, 179), max_r, options);
+    }
+
+    return report(same, "Implementierung ", impl, ", max_r ", max_r, ", Schema ", options.schedule);
+}
+
+
+int main() {
+    // Four textures of different orientation
+    auto angle_at = [](int x, int y) { return (x < 30 ? 30 : 120) + (y > 25 ? 20 : 0); };
+    Mat_<uchar> image = stripes<uchar>(Size(61, 47), angle_at, 127, 120, 0.7, 5);
+
+    vector<Rect> rois = {Rect(0, 5, 20, 30), Rect(20, 5, 20, 30), Rect(40, 5, 21, 42), Rect(3, 3, 9, 9)};
+
+    GLCM::Options every, stride, radii;
+    stride.schedule = GLCM::STRIDE;
+    radii.schedule = GLCM::EXPLICIT;
+    radii.radii = {2, 7, 3};
+
+    bool passed = true;
+
+    for (GLCM::Implementation impl : {GLCM::STANDARD, GLCM::SCHEME1, GLCM::SCHEME2, GLCM::SCHEME3}) {
+        for (unsigned int max_r : {0u, 5u}) {
+            for (const GLCM::Options& options : {every, stride, radii}) {
+                passed &= compare(image, rois, impl, max_r, options);
+            }
+        }
+    }
+
+    // Regions outside of the image are rejected
+    try {
+        GLCM::main_angle_rois(image, {Rect(50, 0, 20, 5)}, GLCM::STANDARD);
+        passed = false;
+    } catch (const invalid_argument&) {}
+
+    return passed ? 0 : 1;
+}
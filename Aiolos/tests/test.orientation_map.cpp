@@ -0,0 +1,61 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+#include <iostream>
+#include <opencv2/opencv.hpp>
+#include <GLCM.h>
+#include <util/TestHelper.h>
+
+using namespace std;
+using namespace cv;
+
+
+/**
+ *  Every angle of the orientation map has to equal GLCM::main_angle of its window cut out of the image
+ *
+ *  @param name         name of the image (output only)
+ *  @param image        the given image
+ *  @param impl         which implementation of the GLCM shall be used
+ *  @return             whether every angle is the same
+ */
+bool compare(const char* name, const Mat& image, GLCM::Implementation impl) {
+    Size window(20, 15), stride(7, 5);
+
+    Mat strength;
+    Mat_<int> angles = GLCM::orientation_map(image, strength, impl, window, stride, GLCM::Range(0, 179), 6);
+
+    bool same = angles.rows == (image.rows - window.height) / stride.height + 1
+                && angles.cols == (image.cols - window.width) / stride.width + 1
+                && strength.size() == angles.size();
+
+    for (int y = 0; same && y < angles.rows; y++) {
+        for (int x = 0; x < angles.cols; x++) {
+            Mat sub = image(Rect(x * stride.width, y * stride.height, window.width, window.height));
+            same &= angles(y, x) == static_cast<int>(GLCM::main_angle(sub, impl, GLCM::Range(0, 179), 6));
+        }
+    }
+
+    return report(same, name, " (Implementierung ", impl, ")");
+}
+
+
+int main() {
+    // Two textures of different orientation (30° left, 120° right)
+    auto angle_at = [](int x, int) { return x < 30 ? 30 : 120; };
+    Mat_<uchar> image8 = stripes<uchar>(Size(60, 45), angle_at, 127, 120, 0.7, 5);
+    Mat_<ushort> image16 = stripes<ushort>(Size(60, 45), angle_at, 30000, 25000, 0.7, 500);
+
+    bool passed = true;
+
+    for (GLCM::Implementation impl : {GLCM::STANDARD, GLCM::SCHEME2, GLCM::SCHEME3}) {
+        passed &= compare("8 Bit", image8, impl);
+    }
+
+    // Scheme 2 may differ for images deeper than 8 bit (see GLCM::orientation_map)
+    for (GLCM::Implementation impl : {GLCM::STANDARD, GLCM::SCHEME3}) {
+        passed &= compare("16 Bit", image16, impl);
+    }
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,67 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+#include <iostream>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include <util/SimdFunctions.h>
+#include <impl/Offsets.h>
+
+using namespace std;
+using namespace cv;
+
+
+/**
+ *  Compares the vectorized kernels of the CPU running the test with the generic (scalar) versions, using the weights
+ *  of real offsets and spans of every length up to more than a whole vector (tails included)
+ *
+ *  @tparam T           single channel type: uchar, ushort
+ *  @param max          highest gray value of the spans
+ *  @return             whether every result is the same
+ */
+template <typename T>
+bool compare(int max) {
+    RNG rng(3);
+    bool same = true;
+
+    for (int n : {0, 1, 3, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000, 70000}) {
+        vector<T> a(n + 1), b(n + 1), c(n + 1), simd(n), scalar(n);
+        for (int i = 0; i <= n; i++) {
+            // Extreme values as well => overflow of the lanes would show up
+            a[i] = static_cast<T>(i % 5 == 0 ? max : rng.uniform(0, max + 1));
+            b[i] = static_cast<T>(i % 7 == 0 ? 0 : rng.uniform(0, max + 1));
+            c[i] = static_cast<T>(rng.uniform(0, max + 1));
+        }
+
+        same &= GLCM::Util::squared_differences(a.data(), b.data(), n)
+                == GLCM::Util::squared_differences<T>(a.data(), b.data(), n);
+
+        for (double r : {1.0, 2.0, 7.0, 25.0}) {
+            for (int theta = 0; theta < 180; theta += 13) {
+                GLCM::Offset o = GLCM::make_offset(r, theta * CV_PI / 180);
+
+                same &= GLCM::Util::interpolated_squared_differences(a.data(), b.data(), c.data(), n,
+                                                                     o.c_1, o.c_2, o.c_3, o.c_4)
+                        == GLCM::Util::interpolated_squared_differences<T>(a.data(), b.data(), c.data(), n,
+                                                                           o.c_1, o.c_2, o.c_3, o.c_4);
+
+                GLCM::Util::interpolate(b.data(), c.data(), n, o.c_1, o.c_2, o.c_3, o.c_4, simd.data());
+                GLCM::Util::interpolate<T>(b.data(), c.data(), n, o.c_1, o.c_2, o.c_3, o.c_4, scalar.data());
+                same &= simd == scalar;
+            }
+        }
+    }
+
+    return same;
+}
+
+
+int main() {
+    bool same_8 = compare<uchar>(255), same_16 = compare<ushort>(65535);
+
+    cout << "8 Bit: " << (same_8 ? "gleich" : "FEHLER") << endl
+         << "16 Bit: " << (same_16 ? "gleich" : "FEHLER") << endl;
+
+    return same_8 && same_16 ? 0 : 1;
+}
@@ -0,0 +1,162 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include <GLCM.h>
+#include <util/TestHelper.h>
+
+using namespace std;
+using namespace cv;
+
+
+/**
+ *  Creates the Standard GLCM of a radius and angle by hand: partner of (x, y) is (x + ⌊r cos θ⌋, y + ⌊r sin θ⌋), only
+ *  pairs with both pixels inside of the image are counted (same offset as GLCM::make_offset)
+ *
+ *  @param image        the given image
+ *  @param r            the radius
+ *  @param angle        the angle (in degrees!)
+ *  @return             the GLCM (256 x 256)
+ */
+Mat_<double> standard_glcm(const Mat_<uchar>& image, unsigned int r, unsigned int angle) {
+    double theta = angle * CV_PI / 180;
+    int dist_x = cvFloor(r * cos(theta)), dist_y = cvFloor(r * sin(theta));
+
+    Mat_<double> glcm(256, 256, 0.0);
+    for (int y = 0; y < image.rows; y++) {
+        for (int x = 0; x < image.cols; x++) {
+            int x2 = x + dist_x, y2 = y + dist_y;
+            if (x2 < 0 || x2 >= image.cols || y2 < 0 || y2 >= image.rows) continue;
+
+            glcm(image(y, x), image(y2, x2))++;
+        }
+    }
+
+    return glcm;
+}
+
+
+/**
+ *  Calculates the Haralick statistics of a GLCM directly from their definitions (see GLCM::TextureFeature)
+ *
+ *  @param glcm         the GLCM (counts)
+ *  @param pairs        the returned number of pairs counted
+ *  @return             the statistics
+ */
+GLCM::TextureFeatures haralick(const Mat_<double>& glcm, double& pairs) {
+    GLCM::TextureFeatures features;
+    double mean_i = 0, mean_j = 0;
+    pairs = 0;
+
+    for (int i = 0; i < glcm.rows; i++) {
+        for (int j = 0; j < glcm.cols; j++) {
+            pairs += glcm(i, j);
+            mean_i += i * glcm(i, j);
+            mean_j += j * glcm(i, j);
+        }
+    }
+
+    if (pairs == 0) return features;
+    mean_i /= pairs;
+    mean_j /= pairs;
+
+    double var_i = 0, var_j = 0, covariance = 0;
+    for (int i = 0; i < glcm.rows; i++) {
+        for (int j = 0; j < glcm.cols; j++) {
+            double p = glcm(i, j) / pairs;
+            if (p == 0) continue;
+
+            features.contrast += (i - j) * (i - j) * p;
+            features.energy += p * p;
+            features.entropy -= p * log(p);
+            features.homogeneity += p / (1 + (i - j) * (i - j));
+
+            var_i += (i - mean_i) * (i - mean_i) * p;
+            var_j += (j - mean_j) * (j - mean_j) * p;
+            covariance += (i - mean_i) * (j - mean_j) * p;
+        }
+    }
+
+    features.correlation = var_i > 0 && var_j > 0 ? covariance / sqrt(var_i * var_j) : 1.0;
+    return features;
+}
+
+
+/// Whether two values are equal except for rounding
+bool close(double a, double b) {
+    return abs(a - b) <= 1e-9 * max(1.0, abs(b));
+}
+
+
+/// Whether all statistics of two GLCMs are equal except for rounding
+bool close(const GLCM::TextureFeatures& a, const GLCM::TextureFeatures& b) {
+    return close(a.contrast, b.contrast) && close(a.energy, b.energy) && close(a.entropy, b.entropy)
+           && close(a.homogeneity, b.homogeneity) && close(a.correlation, b.correlation);
+}
+
+
+/**
+ *  The statistics of every (angle, radius) pair of GLCM::texture_features have to equal the ones of the Standard GLCM
+ *  built by hand, contrast times the number of pairs has to equal Z of the C interface (single angle)
+ */
+int main() {
+    Mat_<uchar> image = stripes(Size(16, 12));
+    bool passed = true;
+
+    for (unsigned int max_r : {1u, 2u}) {
+        GLCM::TextureFeatureMap map = GLCM::texture_features(image, GLCM::STANDARD, GLCM::ALL_TEXTURE_FEATURES,
+                                                             GLCM::Range(0, 179), max_r);
+        vector<GLCM::TextureFeatures> per_angle = GLCM::features_per_angle(map);
+
+        bool features = map.angles.size() == 180 && map.radii.size() == max_r
+                        && map.features.size() == 180 * max_r && per_angle.size() == 180;
+        bool single = true, contrast = true;
+
+        for (unsigned int angle = 0; features && angle < 180; angle++) {
+            GLCM::TextureFeatures mean;
+
+            for (unsigned int r = 1; r <= max_r; r++) {
+                double pairs = 0;
+                GLCM::TextureFeatures expected = haralick(standard_glcm(image, r, angle), pairs);
+                features &= close(map.features[angle * max_r + r - 1], expected);
+
+                mean.contrast += expected.contrast / max_r;
+                mean.energy += expected.energy / max_r;
+                mean.entropy += expected.entropy / max_r;
+                mean.homogeneity += expected.homogeneity / max_r;
+                mean.correlation += expected.correlation / max_r;
+
+                if (r > 1) continue;
+
+                // A single pair => every thread creates a part of the GLCM (merged afterwards)
+                GLCM::TextureFeatureMap alone = GLCM::texture_features(image, GLCM::STANDARD,
+                                                                       GLCM::ALL_TEXTURE_FEATURES,
+                                                                       GLCM::Range(angle, angle), 1);
+                single &= alone.features.size() == 1 && close(alone.features[0], expected);
+
+                aiolos_options options;
+                aiolos_default_options(&options);
+                options.first_angle = options.last_angle = angle;
+                options.max_r = 1;
+
+                vector<double> z = c_distribution(image, options);
+                contrast &= z.size() == 1 && close(expected.contrast * pairs, z[0])
+                            && alone.distribution.size() == 1 && alone.distribution[0] == z[0];
+            }
+
+            features &= close(per_angle[angle], mean);
+        }
+
+        passed &= report(features, "Merkmale + Mittelwert pro Winkel, max_r ", max_r);
+        if (max_r == 1) {
+            passed &= report(single, "Einzelnes Paar (zusammengefuegte GLCM)");
+            passed &= report(contrast, "Kontrast * Paare = Z");
+        }
+    }
+
+    return passed ? 0 : 1;
+}
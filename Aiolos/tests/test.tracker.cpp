@@ -0,0 +1,67 @@
+//
+// Created by thahnen on 18.10.26.
+//
+
+#include <iostream>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include <GLCM.h>
+#include <Tracker.h>
+#include <util/TestHelper.h>
+
+using namespace std;
+using namespace cv;
+
+
+/**
+ *  Every frame of a sequence (stripes of the given angles) has to give the same angle as GLCM::main_angle, only the
+ *  first frame and the one after a jump may search the whole range (every other one only a window)
+ *
+ *  @param name         name of the sequence (output only)
+ *  @param angles       orientation of the stripes of every frame (in degrees, 180 == 0)
+ *  @param range        interval of angles to consider
+ *  @param tracking     settings of the tracking
+ *  @param jump         index of the frame, the orientation jumps at (0 => none)
+ *  @return             whether every frame is the same
+ */
+bool compare(const char* name, const vector<unsigned int>& angles, const GLCM::Range& range,
+             const GLCM::TrackerOptions& tracking, size_t jump = 0) {
+    GLCM::Tracker tracker(GLCM::SCHEME2, range, 8, GLCM::Options(), tracking);
+    bool same = true;
+
+    for (size_t i = 0; i < angles.size(); i++) {
+        Mat_<uchar> frame = stripes(Size(64, 64), angles[i]);
+        unsigned int angle = tracker.update(frame);
+
+        same &= angle == GLCM::main_angle(frame, GLCM::SCHEME2, range, 8)
+                && angle >= range.first && angle <= range.second
+                && tracker.full_search() == (i == 0 || i == jump);
+    }
+
+    return report(same, name);
+}
+
+
+/**
+ *  Tracks synthetic sequences: slow drift (inside of the window), a drift faster than the window (widened at its
+ *  edge), a jump (confidence drops => whole range), the wrap around at 179° / 0° and a range not wrapping around
+ */
+int main() {
+    GLCM::TrackerOptions tracking, widening;
+    tracking.full_search = 0;
+    widening.full_search = 0;
+    widening.confidence_drop = 0;           // only widening, never the whole range
+
+    bool passed = true;
+
+    passed &= compare("Langsame Drift", {40, 42, 44, 47, 50, 52, 55}, GLCM::Range(0, 179), tracking);
+    passed &= compare("Schnelle Drift (Fenster erweitert)", {40, 52, 64, 76}, GLCM::Range(0, 179), widening);
+    passed &= compare("Sprung (ganzer Bereich)", {40, 42, 44, 130, 132}, GLCM::Range(0, 179), tracking, 3);
+    passed &= compare("Uebergang 179 / 0", {172, 175, 178, 181, 184, 187}, GLCM::Range(0, 179), widening);
+
+    // Not wrapping around => the window stops at the bounds of the range, stripes outside give the nearest bound
+    passed &= compare("Untere Grenze", {30, 25, 20, 15, 10, 5}, GLCM::Range(10, 60), widening);
+    passed &= compare("Obere Grenze", {50, 55, 60, 65, 70}, GLCM::Range(10, 60), widening);
+
+    return passed ? 0 : 1;
+}